@@ -0,0 +1,211 @@
+#include "Utils/SpatialGrid.hpp"
+#include "Utils/RectBatch.hpp"
+#include "Utils/ResourceHolder.hpp"
+#include "Utils/ResourceIdentifiers.hpp"
+#include "Game/CommandQueue.hpp"
+#include "Objects/BulletNode.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+#include <set>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+// Stand-in for a collidable scene node, only its bounds matter to the broad phase
+struct Body {
+    sf::FloatRect bounds;
+};
+
+const sf::Vector2f ViewSize(1024.f, 768.f);
+
+std::vector<Body> createBodies(std::size_t count, sf::Vector2f area, unsigned int seed) {
+    std::mt19937 random(seed);
+    // Centered on the origin, so negative cell coordinates are hashed too
+    std::uniform_real_distribution<float> x(-area.x / 2.f, area.x / 2.f);
+    std::uniform_real_distribution<float> y(-area.y / 2.f, area.y / 2.f);
+    std::uniform_real_distribution<float> size(3.f, 84.f);
+
+    std::vector<Body> bodies(count);
+    for (Body& body : bodies)
+        body.bounds = sf::FloatRect(x(random), y(random), size(random), size(random));
+    return bodies;
+}
+
+template <typename Function>
+double measure(Function fn, int repetitions) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i)
+        fn();
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+}
+
+// The scene graph pass the grid replaced, every node against every node into a std::set
+std::size_t bruteForcePairs(const std::vector<Body>& bodies) {
+    std::set<std::pair<const Body*, const Body*>> pairs;
+
+    for (const Body& lhs : bodies)
+        for (const Body& rhs : bodies)
+            if (&lhs != &rhs && lhs.bounds.intersects(rhs.bounds))
+                pairs.insert(std::minmax(&lhs, &rhs));
+
+    return pairs.size();
+}
+
+std::size_t gridPairs(SpatialGrid<const Body>& grid, const std::vector<Body>& bodies) {
+    grid.clear();
+    for (const Body& body : bodies)
+        grid.insert(body, body.bounds, 1u);
+
+    std::size_t pairs = 0;
+    grid.findPairs([] (unsigned int, unsigned int) { return true; }, [&] (const Body&, const Body&) { ++pairs; });
+    return pairs;
+}
+
+void benchBroadPhase() {
+    const std::size_t counts[] = {100, 1000, 5000, 20000};
+
+    std::cout << "Broad phase, grid cells of view / 8 against the old O(n^2) scene pass\n";
+    std::cout << std::left << std::setw(10) << "layout" << std::right << std::setw(10) << "entities"
+        << std::setw(14) << "O(n^2) ms" << std::setw(12) << "grid ms" << std::setw(10) << "speedup" << std::setw(12) << "pairs" << "\n";
+
+    // Spread keeps the density of a level constant, packed puts everything in one view
+    for (bool packed : {false, true}) {
+        for (std::size_t count : counts) {
+            sf::Vector2f area = packed ? ViewSize : sf::Vector2f(ViewSize.x, ViewSize.y * count / 200.f);
+            std::vector<Body> bodies = createBodies(count, area, 42);
+            SpatialGrid<const Body> grid(ViewSize / 8.f);
+
+            int repetitions = std::max(1, static_cast<int>(200000 / (count * count / 100 + 1)));
+            std::size_t expected = 0;
+            std::size_t found = 0;
+
+            double bruteForce = measure([&] { expected = bruteForcePairs(bodies); }, std::min(repetitions, 3));
+            double gridTime = measure([&] { found = gridPairs(grid, bodies); }, std::max(repetitions, 10));
+
+            std::cout << std::left << std::setw(10) << (packed ? "packed" : "spread") << std::right << std::setw(10) << count
+                << std::fixed << std::setprecision(3) << std::setw(14) << bruteForce << std::setw(12) << gridTime
+                << std::setprecision(1) << std::setw(9) << bruteForce / gridTime << "x" << std::setw(12) << found
+                << (found == expected ? "" : "  MISMATCH") << "\n";
+        }
+    }
+}
+
+void benchRectBatch() {
+    const std::size_t counts[] = {1000, 10000, 50000};
+    const std::size_t queries = 64;
+
+    std::cout << "\nRect batch, " << queries << " query rects against every rect, " << RectBatch::Lanes << " lanes against 1\n";
+    std::cout << std::right << std::setw(10) << "rects" << std::setw(14) << "scalar ms" << std::setw(12) << "simd ms"
+        << std::setw(10) << "speedup" << std::setw(12) << "hits" << "\n";
+
+    for (std::size_t count : counts) {
+        sf::Vector2f area(ViewSize.x, ViewSize.y * count / 200.f);
+        std::vector<Body> bodies = createBodies(count, area, 7);
+        std::vector<Body> targets = createBodies(queries, area, 11);
+
+        RectBatch batch;
+        for (const Body& body : bodies)
+            batch.push(body.bounds);
+
+        std::size_t scalarHits = 0;
+        std::size_t simdHits = 0;
+        int repetitions = static_cast<int>(2000000 / count);
+
+        double scalar = measure([&] {
+            scalarHits = 0;
+            for (const Body& target : targets)
+                batch.intersectScalar(target.bounds, 0, batch.size(), [&] (std::size_t) { ++scalarHits; });
+        }, repetitions);
+        double simd = measure([&] {
+            simdHits = 0;
+            for (const Body& target : targets)
+                batch.intersect(target.bounds, 0, batch.size(), [&] (std::size_t) { ++simdHits; });
+        }, repetitions);
+
+        std::cout << std::right << std::setw(10) << count
+            << std::fixed << std::setprecision(4) << std::setw(14) << scalar << std::setw(12) << simd
+            << std::setprecision(1) << std::setw(9) << scalar / simd << "x" << std::setw(12) << simdHits
+            << (simdHits == scalarHits ? "" : "  MISMATCH") << "\n";
+    }
+}
+
+void benchBullets() {
+    const std::size_t bulletCount = 50000;
+    const std::size_t aircraftCounts[] = {1, 8, 32, 128};
+    const int ticks = 100;
+    const sf::Time dt = sf::seconds(1.f / 60.f);
+
+    // Same texture the world loads, the bullet sprite is a rect of it
+    TextureHolder textures;
+    textures.load(Textures::Entities, "../assets/Textures/Entities.png");
+
+    std::mt19937 random(3);
+    sf::Vector2f area(ViewSize.x, ViewSize.y * 4.f);
+    std::uniform_real_distribution<float> x(0.f, area.x);
+    std::uniform_real_distribution<float> y(0.f, area.y);
+    std::uniform_real_distribution<float> speed(-300.f, 300.f);
+
+    // Drawing builds the vertex array and submits it, offscreen so the bench needs no window
+    sf::RenderTexture target;
+    bool drawing = target.create(static_cast<unsigned int>(ViewSize.x), static_cast<unsigned int>(ViewSize.y));
+
+    std::cout << "\nBullet stress, " << bulletCount << " bullets, averaged over " << ticks << " ticks, tick excludes drawing"
+        << (drawing ? "" : ", no render target so drawing is not measured") << "\n";
+    std::cout << std::right << std::setw(10) << "aircraft" << std::setw(12) << "update ms" << std::setw(10) << "cull ms"
+        << std::setw(10) << "hits ms" << std::setw(10) << "tick ms" << std::setw(12) << "ns/bullet" << std::setw(10) << "draw ms"
+        << std::setw(10) << "hits" << "\n";
+
+    for (std::size_t aircraftCount : aircraftCounts) {
+        BulletNode bullets(Projectile::EnemyBullet, textures);
+        for (std::size_t i = 0; i < bulletCount; ++i)
+            bullets.spawn(sf::Vector2f(x(random), y(random)), sf::Vector2f(0.f, speed(random)));
+
+        std::vector<sf::FloatRect> aircraft(aircraftCount);
+        for (sf::FloatRect& rect : aircraft)
+            rect = sf::FloatRect(x(random), y(random), 48.f, 64.f);
+
+        // Bullets are counted instead of killed, so every tick has all of them
+        CommandQueue commands;
+        sf::FloatRect battlefield(-area.x, -area.y, 3.f * area.x, 3.f * area.y);
+        std::size_t hits = 0;
+        double update = 0.0;
+        double cull = 0.0;
+        double scan = 0.0;
+        double draw = 0.0;
+
+        for (int tick = 0; tick < ticks; ++tick) {
+            update += measure([&] { bullets.update(dt, commands); }, 1);
+            cull += measure([&] { bullets.cull(battlefield); }, 1);
+            scan += measure([&] {
+                for (const sf::FloatRect& rect : aircraft)
+                    bullets.findHits(rect, [&] (std::size_t) { ++hits; });
+            }, 1);
+
+            if (drawing) {
+                draw += measure([&] {
+                    target.clear();
+                    target.draw(bullets);
+                    target.display();
+                }, 1);
+            }
+        }
+
+        double tick = (update + cull + scan) / ticks;
+        std::cout << std::setw(10) << aircraftCount << std::fixed << std::setprecision(3)
+            << std::setw(12) << update / ticks << std::setw(10) << cull / ticks << std::setw(10) << scan / ticks
+            << std::setw(10) << tick << std::setprecision(1) << std::setw(12) << tick * 1e6 / bulletCount
+            << std::setprecision(3) << std::setw(10) << draw / ticks << std::setw(10) << hits / ticks << "\n";
+    }
+}
+
+int main() {
+    benchBroadPhase();
+    benchRectBatch();
+    benchBullets();
+}
@@ -0,0 +1,184 @@
+#if !defined(DESERT_RAID_COUNT_ALLOCS)
+    #error "bench_commands counts heap allocations, build it with DESERT_RAID_COUNT_ALLOCS defined"
+#endif
+
+#include "Utils/AllocationCounter.hpp"
+#include "Game/Command.hpp"
+#include "Game/CommandQueue.hpp"
+#include "Game/EventBus.hpp"
+#include "Utils/MpscQueue.hpp"
+#include "Objects/SceneNode.hpp"
+#include "Objects/SceneRegistry.hpp"
+
+#include <SFML/System.hpp>
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+// Stand-in for the aircraft and projectiles commands are aimed at
+class Target : public SceneNode {
+    public:
+        explicit Target(Category::Type category);
+        void hit(int damage);
+        long long getDamage() const;
+    private:
+        long long mDamage;
+};
+
+Target::Target(Category::Type category)
+: SceneNode(category), mDamage(0) {
+}
+
+void Target::hit(int damage) {
+    mDamage += damage;
+}
+
+long long Target::getDamage() const {
+    return mDamage;
+}
+
+const Category::Type TargetCategories[] = {
+    Category::PlayerAircraft,
+    Category::EnemyAircraft,
+    Category::AlliedProjectile,
+    Category::EnemyProjectile
+};
+
+// One tick of the world's command loop, more commands than the queue's initial capacity
+void runTick(CommandQueue& queue, const SceneRegistry& registry, std::size_t commands, sf::Time dt) {
+    for (std::size_t i = 0; i < commands; ++i) {
+        Command command;
+        command.category = TargetCategories[i % 4];
+        command.origin = "Benchmark";
+
+        int damage = static_cast<int>(i % 7) + 1;
+        command.action = derivedAction<Target>([damage] (Target& target, sf::Time) {
+            target.hit(damage);
+        });
+        queue.push(command);
+    }
+
+    queue.swapBuffers();
+    while (!queue.isEmpty()) {
+        Command command = queue.pop();
+        registry.forEach(command.category, [&] (SceneNode& node) {
+            command.action(node, dt);
+        });
+    }
+}
+
+void benchCommandAllocations() {
+    const std::size_t commandCounts[] = {16, 64, 256};
+    const std::size_t ticks = 10000;
+    const sf::Time dt = sf::seconds(1.f / 60.f);
+
+    EventBus events;
+    SceneRegistry registry(events);
+    SceneNode root;
+    root.setRegistry(registry);
+
+    for (std::size_t i = 0; i < 64; ++i)
+        root.attachChild(SceneNode::Ptr(new Target(TargetCategories[i % 4])));
+
+    std::cout << "Command queue, push, swap and dispatch over " << ticks << " ticks\n";
+    std::cout << std::right << std::setw(16) << "commands/tick" << std::setw(14) << "ns/command"
+        << std::setw(14) << "allocations" << std::setw(16) << "per command" << "\n";
+
+    for (std::size_t commands : commandCounts) {
+        CommandQueue queue;
+
+        // Both ring buffers grow to the tick's peak once, after that every slot is reused
+        for (int warmup = 0; warmup < 10; ++warmup)
+            runTick(queue, registry, commands, dt);
+
+        std::size_t allocations = 0;
+        auto start = std::chrono::steady_clock::now();
+        {
+            AllocationCounter::Scope counting;
+            std::size_t before = AllocationCounter::getCount();
+            for (std::size_t tick = 0; tick < ticks; ++tick)
+                runTick(queue, registry, commands, dt);
+            allocations = AllocationCounter::getCount() - before;
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << std::setw(16) << commands << std::fixed << std::setprecision(1)
+            << std::setw(14) << elapsed.count() / (ticks * commands) << std::setw(14) << allocations
+            << std::setprecision(4) << std::setw(16) << static_cast<double>(allocations) / (ticks * commands)
+            << (allocations == 0 ? "" : "  ALLOCATES") << "\n";
+    }
+}
+
+void benchConcurrentCommands() {
+    const std::size_t producerCounts[] = {1, 2, 4, 8, 16};
+    const std::size_t commandsPerProducer = 200000;
+
+    std::cout << "\nConcurrent command queue, " << commandsPerProducer << " commands per producer into a 1024 slot ring\n";
+    std::cout << std::right << std::setw(10) << "producers" << std::setw(14) << "ns/command"
+        << std::setw(14) << "full retries" << std::setw(14) << "allocations" << "\n";
+
+    for (std::size_t producers : producerCounts) {
+        MpscQueue<Command> queue(1024);
+        std::atomic<std::size_t> retries(0);
+        std::atomic<std::size_t> allocations(0);
+        std::atomic<bool> go(false);
+        std::vector<std::thread> threads;
+
+        for (std::size_t producer = 0; producer < producers; ++producer) {
+            threads.emplace_back([&] {
+                Command command;
+                command.category = Category::PlayerAircraft;
+                command.origin = "Benchmark";
+                command.action = derivedAction<Target>([] (Target& target, sf::Time) {
+                    target.hit(1);
+                });
+
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                // Counted per producer thread, the consumer is not part of the push cost
+                AllocationCounter::Scope counting;
+                std::size_t before = AllocationCounter::getCount();
+                std::size_t full = 0;
+                for (std::size_t i = 0; i < commandsPerProducer; ++i) {
+                    while (!queue.push(command)) {
+                        ++full;
+                        std::this_thread::yield();
+                    }
+                }
+
+                allocations += AllocationCounter::getCount() - before;
+                retries += full;
+            });
+        }
+
+        // The world thread drains the ring once per tick, here as fast as it can
+        std::size_t received = 0;
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        while (received < producers * commandsPerProducer) {
+            Command command;
+            if (queue.tryPop(command))
+                ++received;
+            else
+                std::this_thread::yield();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        std::cout << std::setw(10) << producers << std::fixed << std::setprecision(1)
+            << std::setw(14) << elapsed.count() / received << std::setw(14) << retries.load()
+            << std::setw(14) << allocations.load() << (allocations.load() == 0 ? "" : "  ALLOCATES") << "\n";
+    }
+}
+
+int main() {
+    benchCommandAllocations();
+    benchConcurrentCommands();
+}
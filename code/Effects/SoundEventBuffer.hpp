@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Effects/SoundEffect.hpp"
+
+#include <SFML/System.hpp>
+
+#include <array>
+
+// Positional sounds requested during a tick, handed to the SoundPlayer in one go
+class SoundEventBuffer : private sf::NonCopyable {
+    public:
+        struct Event {
+            SoundEffect::ID effect;
+            sf::Vector2f position;
+        };
+    public:
+        SoundEventBuffer();
+        void push(SoundEffect::ID effect, sf::Vector2f position);
+        void flush(SoundPlayer& player);
+    private:
+        static const std::size_t Capacity = 64;
+    private:
+        std::array<Event, Capacity> mEvents;
+        std::size_t mSize;
+};
+
+SoundEventBuffer::SoundEventBuffer()
+: mEvents(), mSize(0) {
+}
+
+void SoundEventBuffer::push(SoundEffect::ID effect, sf::Vector2f position) {
+    // More sounds than this in one tick are not heard apart anyway, the rest are dropped
+    if (mSize < Capacity)
+        mEvents[mSize++] = Event{effect, position};
+}
+
+void SoundEventBuffer::flush(SoundPlayer& player) {
+    for (std::size_t i = 0; i < mSize; ++i)
+        player.play(mEvents[i].effect, mEvents[i].position);
+
+    mSize = 0;
+}
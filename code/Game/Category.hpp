@@ -11,7 +11,8 @@ namespace Category {
         AlliedProjectile    = 1 << 5,
         EnemyProjectile     = 1 << 6,
         ParticleSystem      = 1 << 7,
-        SoundEffect         = 1 << 8,
+        ParticleEmitter     = 1 << 8,
+        BulletSystem        = 1 << 9,
 
         Aircraft = PlayerAircraft | AlliedAircraft | EnemyAircraft,
         Projectile = AlliedProjectile | EnemyProjectile,
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Game/Category.hpp"
+
+#include <array>
+#include <limits>
+
+class CollisionMatrix {
+    public:
+        CollisionMatrix();
+        void add(Category::Type first, Category::Type second);
+        bool matches(unsigned int first, unsigned int second) const;
+        bool collides(unsigned int lhs, unsigned int rhs) const;
+        unsigned int getCategories() const;
+    private:
+        std::array<unsigned int, std::numeric_limits<unsigned int>::digits> mRows;
+        unsigned int mCategories;
+};
+
+CollisionMatrix::CollisionMatrix()
+: mRows(), mCategories(Category::None) {
+}
+
+void CollisionMatrix::add(Category::Type first, Category::Type second) {
+    for (std::size_t bit = 0; bit < mRows.size(); ++bit)
+        if (first & (1u << bit))
+            mRows[bit] |= second;
+
+    mCategories |= first | second;
+}
+
+bool CollisionMatrix::matches(unsigned int first, unsigned int second) const {
+    for (std::size_t bit = 0; first != 0; ++bit, first >>= 1)
+        if ((first & 1u) && (mRows[bit] & second))
+            return true;
+
+    return false;
+}
+
+bool CollisionMatrix::collides(unsigned int lhs, unsigned int rhs) const {
+    return matches(lhs, rhs) || matches(rhs, lhs);
+}
+
+unsigned int CollisionMatrix::getCategories() const {
+    return mCategories;
+}
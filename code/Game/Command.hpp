@@ -4,24 +4,83 @@
 
 #include <SFML/System.hpp>
 
-#include <functional>
-#include <cassert>
+#include <cstring>
+#include <cstddef>
+#include <new>
+#include <type_traits>
 
 class SceneNode;
 
+// Callable stored inline, copying a command never allocates
+class CommandAction {
+    public:
+        static const std::size_t StorageSize = 4 * sizeof(void*);
+    public:
+        CommandAction();
+
+        template <typename Function, typename = typename std::enable_if<!std::is_same<Function, CommandAction>::value>::type>
+        CommandAction(Function fn);
+
+        void operator() (SceneNode& node, sf::Time dt) const;
+        explicit operator bool() const;
+    private:
+        template <typename Function>
+        static void invoke(const void* storage, SceneNode& node, sf::Time dt);
+    private:
+        typename std::aligned_storage<StorageSize, alignof(std::max_align_t)>::type mStorage;
+        void (*mInvoke)(const void*, SceneNode&, sf::Time);
+};
+
 struct Command {
     Command();
-    std::function<void(SceneNode&, sf::Time)> action;
+    CommandAction action;
     unsigned int category;
+    const char* origin;
 };
 
-Command::Command() : action(), category(Category::None) {
+template <typename GameObject, typename Function>
+struct DerivedAction {
+    void operator() (SceneNode& node, sf::Time dt) const {
+        fn(static_cast<GameObject&>(node), dt);
+    }
+
+    Function fn;
+};
+
+CommandAction::CommandAction()
+: mStorage(), mInvoke(nullptr) {
+}
+
+template <typename Function, typename>
+CommandAction::CommandAction(Function fn)
+: mStorage(), mInvoke(&CommandAction::invoke<Function>) {
+    // Actions are copied bytewise and never destroyed, so captures must be plain data
+    static_assert(sizeof(Function) <= StorageSize, "Command action captures too much state");
+    static_assert(alignof(Function) <= alignof(std::max_align_t), "Command action is over-aligned");
+    static_assert(std::is_trivially_copyable<Function>::value, "Command action must be trivially copyable");
+    static_assert(std::is_trivially_destructible<Function>::value, "Command action must be trivially destructible");
+
+    new (&mStorage) Function(fn);
+}
+
+void CommandAction::operator() (SceneNode& node, sf::Time dt) const {
+    mInvoke(&mStorage, node, dt);
 }
 
+CommandAction::operator bool() const {
+    return mInvoke != nullptr;
+}
+
+template <typename Function>
+void CommandAction::invoke(const void* storage, SceneNode& node, sf::Time dt) {
+    (*static_cast<const Function*>(storage))(node, dt);
+}
+
+Command::Command() : action(), category(Category::None), origin("Untagged") {
+}
+
+// Categories already select the node type, so the cast is resolved at compile time
 template <typename GameObject, typename Function>
-std::function<void(SceneNode&, sf::Time)> derivedAction(Function fn) {
-    return [=] (SceneNode& node, sf::Time dt) {
-        assert(dynamic_cast<GameObject*>(&node) != nullptr);
-        fn(static_cast<GameObject&>(node), dt);
-    };
-}
\ No newline at end of file
+DerivedAction<GameObject, Function> derivedAction(Function fn) {
+    return DerivedAction<GameObject, Function>{fn};
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Game/Command.hpp"
+
+#include <SFML/System.hpp>
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+// Per-origin command statistics, for the last tick and since the start. Node counts are always
+// kept, dispatch is only timed with DESERT_RAID_PROFILE_COMMANDS so a normal build reads no clock.
+class CommandProfiler {
+    public:
+        // Bucket entries walked, wrecks included, and the nodes the action ran on
+        struct Record {
+            const char* origin;
+            unsigned int categories;
+            std::size_t commands;
+            std::size_t visited;
+            std::size_t matched;
+            sf::Time time;
+        };
+
+        class Timer {
+            public:
+                sf::Time getElapsedTime() const;
+            private:
+                #if defined(DESERT_RAID_PROFILE_COMMANDS)
+                sf::Clock mClock;
+                #endif
+        };
+    public:
+        CommandProfiler();
+        void beginTick();
+        void record(const Command& command, std::size_t visited, std::size_t matched, sf::Time time);
+        void endTick();
+        const std::vector<Record>& getLastTick() const;
+        void report(std::ostream& stream) const;
+        static bool isTimed();
+    private:
+        static void add(std::vector<Record>& records, const Record& sample);
+    private:
+        std::vector<Record> mCurrentTick;
+        std::vector<Record> mLastTick;
+        std::vector<Record> mTotals;
+        std::size_t mTickCount;
+};
+
+sf::Time CommandProfiler::Timer::getElapsedTime() const {
+    #if defined(DESERT_RAID_PROFILE_COMMANDS)
+    return mClock.getElapsedTime();
+    #else
+    return sf::Time::Zero;
+    #endif
+}
+
+CommandProfiler::CommandProfiler()
+: mCurrentTick(), mLastTick(), mTotals(), mTickCount(0) {
+}
+
+void CommandProfiler::beginTick() {
+    mCurrentTick.clear();
+}
+
+void CommandProfiler::record(const Command& command, std::size_t visited, std::size_t matched, sf::Time time) {
+    add(mCurrentTick, Record{command.origin, command.category, 1, visited, matched, time});
+}
+
+void CommandProfiler::endTick() {
+    for (const Record& record : mCurrentTick)
+        add(mTotals, record);
+
+    mLastTick.swap(mCurrentTick);
+    ++mTickCount;
+}
+
+const std::vector<CommandProfiler::Record>& CommandProfiler::getLastTick() const {
+    return mLastTick;
+}
+
+void CommandProfiler::report(std::ostream& stream) const {
+    stream << "Command dispatch over " << mTickCount << " ticks";
+    if (!isTimed())
+        stream << ", not timed, configure with DESERT_RAID_PROFILE_COMMANDS=ON";
+    stream << "\n" << std::left << std::setw(32) << "origin" << std::right
+        << std::setw(12) << "categories" << std::setw(10) << "commands" << std::setw(10) << "visited"
+        << std::setw(10) << "matched" << std::setw(12) << "total ms" << std::setw(12) << "us/tick" << "\n";
+
+    for (const Record& record : mTotals) {
+        double micros = static_cast<double>(record.time.asMicroseconds());
+
+        stream << std::left << std::setw(32) << record.origin << std::right
+            << std::setw(12) << std::hex << std::showbase << record.categories << std::dec << std::noshowbase
+            << std::setw(10) << record.commands << std::setw(10) << record.visited << std::setw(10) << record.matched
+            << std::setw(12) << std::fixed << std::setprecision(3) << micros / 1000.0
+            << std::setw(12) << std::setprecision(2) << micros / std::max<std::size_t>(1, mTickCount) << "\n";
+    }
+}
+
+bool CommandProfiler::isTimed() {
+    #if defined(DESERT_RAID_PROFILE_COMMANDS)
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+void CommandProfiler::add(std::vector<Record>& records, const Record& sample) {
+    // Origins are string literals, a handful per tick, so a linear search is enough
+    for (Record& record : records) {
+        if (record.categories == sample.categories && (record.origin == sample.origin || std::strcmp(record.origin, sample.origin) == 0)) {
+            record.commands += sample.commands;
+            record.visited += sample.visited;
+            record.matched += sample.matched;
+            record.time += sample.time;
+            return;
+        }
+    }
+
+    records.push_back(sample);
+}
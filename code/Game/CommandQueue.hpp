@@ -1,28 +1,47 @@
 #pragma once
 
 #include "Game/Command.hpp"
+#include "Utils/RingBuffer.hpp"
 
-#include <queue>
+#include <utility>
+#include <cassert>
 
 class CommandQueue {
     public:
+        CommandQueue();
         void push(const Command& command);
+        void push(Command&& command);
         Command pop();
         bool isEmpty() const;
+        void swapBuffers();
     private:
-        std::queue<Command> mQueue;
+        // Commands are pushed to the back buffer and popped from the front one
+        RingBuffer<Command> mFront;
+        RingBuffer<Command> mBack;
 };
 
+CommandQueue::CommandQueue()
+: mFront(64), mBack(64) {
+}
+
 void CommandQueue::push(const Command& command) {
-    mQueue.push(command);
+    mBack.push(command);
+}
+
+void CommandQueue::push(Command&& command) {
+    mBack.push(std::move(command));
 }
 
 Command CommandQueue::pop() {
-    Command command = mQueue.front();
-    mQueue.pop();
-    return command;
+    return mFront.pop();
 }
 
 bool CommandQueue::isEmpty() const {
-    return mQueue.empty();
+    return mFront.isEmpty();
+}
+
+void CommandQueue::swapBuffers() {
+    // Everything pushed since the last swap becomes this tick's work
+    assert(mFront.isEmpty());
+    mFront.swap(mBack);
 }
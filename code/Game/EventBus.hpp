@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SFML/System.hpp>
+
+#include <vector>
+#include <tuple>
+#include <algorithm>
+
+class SceneNode;
+
+// A node entered the scene graph
+struct NodeSpawned {
+    SceneNode* node;
+    unsigned int category;
+};
+
+// A node stopped being alive, it may stay in the scene for a while (explosions)
+struct NodeDestroyed {
+    SceneNode* node;
+    unsigned int category;
+};
+
+// A node is marked for removal and will be freed when the world compacts its tombstones
+struct NodeRemoved {
+    SceneNode* node;
+    unsigned int category;
+};
+
+struct PlayerDied {
+};
+
+struct PlayerReachedEnd {
+};
+
+// Subscribers implement onEvent(const Event&), publishing walks a prebuilt list and never allocates
+class EventBus : private sf::NonCopyable {
+    public:
+        template <typename Event, typename Object>
+        void subscribe(Object& object);
+
+        template <typename Event, typename Object>
+        void unsubscribe(Object& object);
+
+        template <typename Event>
+        void publish(const Event& event) const;
+    private:
+        template <typename Event>
+        struct Subscriber {
+            void* object;
+            void (*handler)(void*, const Event&);
+        };
+
+        template <typename Event>
+        struct Channel {
+            std::vector<Subscriber<Event>> subscribers;
+        };
+    private:
+        std::tuple<Channel<NodeSpawned>, Channel<NodeDestroyed>, Channel<NodeRemoved>, Channel<PlayerDied>, Channel<PlayerReachedEnd>> mChannels;
+};
+
+template <typename Event, typename Object>
+void EventBus::subscribe(Object& object) {
+    auto handler = [] (void* subscriber, const Event& event) {
+        static_cast<Object*>(subscriber)->onEvent(event);
+    };
+
+    std::get<Channel<Event>>(mChannels).subscribers.push_back(Subscriber<Event>{&object, handler});
+}
+
+template <typename Event, typename Object>
+void EventBus::unsubscribe(Object& object) {
+    std::vector<Subscriber<Event>>& subscribers = std::get<Channel<Event>>(mChannels).subscribers;
+    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [&] (const Subscriber<Event>& s) {
+        return s.object == &object;
+    }), subscribers.end());
+}
+
+template <typename Event>
+void EventBus::publish(const Event& event) const {
+    for (const Subscriber<Event>& subscriber : std::get<Channel<Event>>(mChannels).subscribers)
+        subscriber.handler(subscriber.object, event);
+}
@@ -1,7 +1,6 @@
 #pragma once
 
-#include "Game/CommandQueue.hpp"
-#include "Objects/Aircraft.hpp"
+#include "Game/PlayerInput.hpp"
 
 #include <SFML/Window.hpp>
 
@@ -10,13 +9,13 @@
 class Player {
     public:
         enum Action {
-            MoveLeft,
-            MoveRight,
-            MoveUp,
-            MoveDown,
-            Fire, 
-            LaunchMissile,
-            ActionCount
+            MoveLeft = PlayerInput::MoveLeft,
+            MoveRight = PlayerInput::MoveRight,
+            MoveUp = PlayerInput::MoveUp,
+            MoveDown = PlayerInput::MoveDown,
+            Fire = PlayerInput::Fire, 
+            LaunchMissile = PlayerInput::LaunchMissile,
+            ActionCount = PlayerInput::ActionCount
         };
 
         enum MissionStatus {
@@ -26,58 +25,51 @@ class Player {
         };
     public:
         Player();
-        void handleEvent(const sf::Event& event, CommandQueue& commands);
-        void handleRealtimeInput(CommandQueue& commands);
+        void handleEvent(const sf::Event& event);
+        void handleRealtimeInput();
+        PlayerInput popInput();
         void assignKey(Action action, sf::Keyboard::Key key);
         sf::Keyboard::Key getAssignKey(Action action) const;
         void setMissionStatus(MissionStatus status);
         MissionStatus getMissionStatus() const;
     private:
-        void initializeActions();
         static bool isRealtimeAction(Action action);
     private:
         std::map<sf::Keyboard::Key, Action> mKeyBinding;
-        std::map<Action, Command> mActionBinding;
+        PlayerInput mInput;
         MissionStatus mCurrentMissionStatus;
 };
 
-struct AircraftMover {
-    AircraftMover(float vx, float vy) : velocity(vx, vy) {
-    }
-    void operator() (Aircraft& aircraft, sf::Time) const {
-        aircraft.accelerate(velocity * aircraft.getMaxSpeed());
-    }
-
-    sf::Vector2f velocity;
-};
-
 Player::Player() 
-: mCurrentMissionStatus(MissionRunning) {
+: mInput(), mCurrentMissionStatus(MissionRunning) {
     mKeyBinding[sf::Keyboard::Left] = MoveLeft;
     mKeyBinding[sf::Keyboard::Right] = MoveRight;
     mKeyBinding[sf::Keyboard::Up] = MoveUp;
     mKeyBinding[sf::Keyboard::Down] = MoveDown;
     mKeyBinding[sf::Keyboard::Space] = Fire;
     mKeyBinding[sf::Keyboard::M] = LaunchMissile;
-
-    initializeActions();
-
-    for (auto& pair : mActionBinding)
-        pair.second.category = Category::PlayerAircraft;
 }
 
-void Player::handleEvent(const sf::Event& event, CommandQueue& commands) {
+void Player::handleEvent(const sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         auto found = mKeyBinding.find(event.key.code);
 		if (found != mKeyBinding.end() && !isRealtimeAction(found->second))
-			commands.push(mActionBinding[found->second]);
+			mInput.set(static_cast<PlayerInput::Action>(found->second));
     }
 }
 
-void Player::handleRealtimeInput(CommandQueue& commands) {
+void Player::handleRealtimeInput() {
     for (auto& pair : mKeyBinding) 
-        if (sf::Keyboard::isKeyPressed(pair.first) && isRealtimeAction(pair.second))
-            commands.push(mActionBinding[pair.second]);
+        if (isRealtimeAction(pair.second) && sf::Keyboard::isKeyPressed(pair.first))
+            mInput.set(static_cast<PlayerInput::Action>(pair.second));
+}
+
+PlayerInput Player::popInput() {
+    // Presses gathered since the last tick, the next record starts empty
+    PlayerInput input = mInput;
+    mInput = PlayerInput();
+    mInput.tick = input.tick + 1;
+    return input;
 }
 
 void Player::assignKey(Action action, sf::Keyboard::Key key) {
@@ -107,15 +99,6 @@ Player::MissionStatus Player::getMissionStatus() const {
     return mCurrentMissionStatus;
 }
 
-void Player::initializeActions() {
-	mActionBinding[MoveLeft].action	 = derivedAction<Aircraft>(AircraftMover(-1, 0.f));
-	mActionBinding[MoveRight].action = derivedAction<Aircraft>(AircraftMover(+1, 0.f));
-	mActionBinding[MoveUp].action    = derivedAction<Aircraft>(AircraftMover(0.f, -1));
-	mActionBinding[MoveDown].action  = derivedAction<Aircraft>(AircraftMover(0.f, +1));
-    mActionBinding[Fire].action = derivedAction<Aircraft>([] (Aircraft& a, sf::Time){ a.fire(); });
-    mActionBinding[LaunchMissile].action = derivedAction<Aircraft>([] (Aircraft& a, sf::Time){ a.launchMissile(); });
-}
-
 bool Player::isRealtimeAction(Action action) {
     switch (action) {
 		case MoveLeft:
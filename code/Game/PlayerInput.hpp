@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/System.hpp>
+
+// One tick of player input, a fixed little-endian record when serialized
+struct PlayerInput {
+    enum Action {
+        MoveLeft,
+        MoveRight,
+        MoveUp,
+        MoveDown,
+        Fire,
+        LaunchMissile,
+        ActionCount
+    };
+
+    static const std::size_t SerializedSize = 5;
+
+    PlayerInput();
+    void set(Action action);
+    bool isActive(Action action) const;
+    sf::Vector2f getAxis() const;
+    void serialize(sf::Uint8* bytes) const;
+    static PlayerInput deserialize(const sf::Uint8* bytes);
+
+    sf::Uint32 tick;
+    sf::Uint8 actions;
+};
+
+PlayerInput::PlayerInput()
+: tick(0), actions(0) {
+}
+
+void PlayerInput::set(Action action) {
+    actions |= static_cast<sf::Uint8>(1u << action);
+}
+
+bool PlayerInput::isActive(Action action) const {
+    return (actions >> action) & 1u;
+}
+
+sf::Vector2f PlayerInput::getAxis() const {
+    // Opposite directions held together cancel out
+    return sf::Vector2f(static_cast<float>(isActive(MoveRight)) - static_cast<float>(isActive(MoveLeft)),
+                        static_cast<float>(isActive(MoveDown)) - static_cast<float>(isActive(MoveUp)));
+}
+
+void PlayerInput::serialize(sf::Uint8* bytes) const {
+    for (std::size_t i = 0; i < 4; ++i)
+        bytes[i] = static_cast<sf::Uint8>(tick >> (8 * i));
+
+    bytes[4] = actions;
+}
+
+PlayerInput PlayerInput::deserialize(const sf::Uint8* bytes) {
+    PlayerInput input;
+    for (std::size_t i = 0; i < 4; ++i)
+        input.tick |= static_cast<sf::Uint32>(bytes[i]) << (8 * i);
+
+    input.actions = bytes[4];
+    return input;
+}
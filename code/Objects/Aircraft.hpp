@@ -3,14 +3,16 @@
 #include "Objects/Entity.hpp"
 #include "Objects/TextNode.hpp"
 #include "Objects/Projectile.hpp"
+#include "Objects/BulletNode.hpp"
 #include "Objects/Pickup.hpp"
-#include "Objects/SoundNode.hpp"
-#include "Effects/Animation.hpp"
+#include "Objects/NodePool.hpp"
+#include "Effects/SoundEventBuffer.hpp"
 #include "Utils/ResourceIdentifiers.hpp"
 #include "Utils/Utility.hpp"
 
 #include <vector>
 #include <functional>
+#include <cstdio>
 
 struct Direction {
     Direction(float angle, float distance)
@@ -29,6 +31,10 @@ struct AircraftData {
     sf::Time fireInterval;
     std::vector<Direction> directions;
     bool hasRollAnimation;
+    Textures::ID explosionTexture;
+    sf::Vector2i explosionFrameSize;
+    int explosionFrames;
+    sf::Time explosionDuration;
 };
 
 std::vector<AircraftData> initializeAircraftData();
@@ -44,11 +50,10 @@ class Aircraft : public Entity {
             TypeCount,
         };
     public:
-        Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts);
-        virtual unsigned int getCategory() const;
-        virtual sf::FloatRect getBoundingRect() const;
+        Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts, SoundEventBuffer& sounds);
+        virtual const sf::Sprite* getCollisionSprite() const;
         virtual void remove();
-        virtual bool isMarkedForRemoval() const;
+        Type getAircraftType() const;
         bool isAllied() const;
         float getMaxSpeed() const;
         void increaseFireRate();
@@ -56,24 +61,30 @@ class Aircraft : public Entity {
         void collectMissiles(unsigned int count);
         void fire();
         void launchMissile();
-        void playLocalSound(CommandQueue& commands, SoundEffect::ID effect);
+        void playLocalSound(SoundEffect::ID effect);
     private:
+        virtual std::size_t getNodeSize() const;
         virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
         virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
+        virtual void onDestroy();
+        virtual sf::FloatRect computeBoundingRect() const;
         void updateMovementPattern(sf::Time dt);
         void checkPickupDrop(CommandQueue& commands);
         void checkProjectileLaunch(sf::Time dt, CommandQueue& commands);
-        void createBullets(SceneNode& node, const TextureHolder& textures) const;
-        void createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset, const TextureHolder& textures) const;
-        void createPickup(SceneNode& node, const TextureHolder& textures) const;
+        void createBullets(BulletNode& bullets) const;
+        void createBullet(BulletNode& bullets, float xOffset, float yOffset) const;
+        void createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset) const;
+        void createPickup(SceneNode& node) const;
         void updateText();
+        void updateTextNodes();
         void updateRollAnimation();
     private:
         Type mType;
         sf::Sprite mSprite;
-        Animation mExplosion;
-        Command mFireCommand;
-        Command mMissileCommand;
+        const TextureHolder& mTextures;
+        const FontHolder& mFonts;
+        SoundEventBuffer& mSounds;
+        sf::Time mExplosionTime;
         sf::Time mFireCountdown;
         bool mIsFiring;
         bool mIsLaunchingMissile;
@@ -83,11 +94,12 @@ class Aircraft : public Entity {
         int mFireRateLevel;
         int mSpreadLevel;
         int mMissileAmmo;
-        Command mDropPickupCommand;
         float mTravelledDistance;
         std::size_t mDirectionIndex;
         TextNode* mHealthDisplay;
         TextNode* mMissileDisplay;
+        int mDisplayedHitpoints;
+        int mDisplayedAmmo;
 };
 
 std::vector<AircraftData> initializeAircraftData() {
@@ -122,6 +134,14 @@ std::vector<AircraftData> initializeAircraftData() {
     data[Aircraft::Avenger].fireInterval = sf::seconds(2);
     data[Aircraft::Avenger].hasRollAnimation = false;
 
+    // One explosion clip per type, an aircraft only keeps its own playback time
+    for (AircraftData& aircraft : data) {
+        aircraft.explosionTexture = Textures::Explosion;
+        aircraft.explosionFrameSize = sf::Vector2i(256, 256);
+        aircraft.explosionFrames = 16;
+        aircraft.explosionDuration = sf::seconds(1);
+    }
+
     return data;
 }
 
@@ -148,13 +168,14 @@ std::vector<PickupData> initializePickupData() {
     return data;
 }
 
-Aircraft::Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts)
-: Entity(AircraftTable[type].hitpoints), 
+Aircraft::Aircraft(Type type, const TextureHolder& textures, const FontHolder& fonts, SoundEventBuffer& sounds)
+: Entity(AircraftTable[type].hitpoints, (type == Eagle) ? Category::PlayerAircraft : Category::EnemyAircraft), 
 mType(type), 
 mSprite(textures.get(AircraftTable[type].texture), AircraftTable[type].textureRect),
-mExplosion(textures.get(Textures::Explosion)),
-mFireCommand(), 
-mMissileCommand(), 
+mTextures(textures),
+mFonts(fonts),
+mSounds(sounds),
+mExplosionTime(sf::Time::Zero), 
 mFireCountdown(sf::Time::Zero), 
 mIsFiring(false), 
 mIsLaunchingMissile(false),
@@ -164,49 +185,35 @@ mSpawnedPickup(false),
 mFireRateLevel(1), 
 mSpreadLevel(1), 
 mMissileAmmo(2), 
-mDropPickupCommand(), 
 mTravelledDistance(0.f), 
 mDirectionIndex(0), 
 mHealthDisplay(nullptr), 
-mMissileDisplay(nullptr) {
-    mExplosion.setFrameSize(sf::Vector2i(256, 256));
-    mExplosion.setNumFrames(16);
-    mExplosion.setDuration(sf::seconds(1));
-    Utility::centerOrigin(mExplosion);
-
+mMissileDisplay(nullptr), 
+mDisplayedHitpoints(-1), 
+mDisplayedAmmo(-1) {
     Utility::centerOrigin(mSprite);
-    mFireCommand.category = Category::SceneAirLayer;
-    mFireCommand.action = [this, &textures] (SceneNode& node, sf::Time) {
-        createBullets(node, textures);
-    };
-
-    mMissileCommand.category = Category::SceneAirLayer;
-    mMissileCommand.action = [this, &textures] (SceneNode& node, sf::Time) {
-        createProjectile(node, Projectile::Missile, 0.f, 0.5f, textures);
-    };
-
-    mDropPickupCommand.category = Category::SceneAirLayer;
-    mDropPickupCommand.action = [this, &textures] (SceneNode& node, sf::Time) {
-        createPickup(node, textures);
-    };
-
-    std::unique_ptr<TextNode> healthDisplay(new TextNode(fonts, ""));
-    mHealthDisplay = healthDisplay.get();
-    SceneNode::attachChild(std::move(healthDisplay));
-
-    if (getCategory() == Category::PlayerAircraft) {
-        std::unique_ptr<TextNode> missileDisplay(new TextNode(fonts, ""));
-        missileDisplay->setPosition(0, 70);
-        mMissileDisplay = missileDisplay.get();
-        SceneNode::attachChild(std::move(missileDisplay));
-    }
 
+    updateTextNodes();
     updateText();
 }
 
+std::size_t Aircraft::getNodeSize() const {
+    return sizeof(Aircraft);
+}
+
 void Aircraft::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const {
     if (Entity::isDestroyed() && mShowExplosion) {
-        target.draw(mExplosion, states);
+        // The clip is shared by the type, the current frame follows from the playback time
+        const AircraftData& data = AircraftTable[mType];
+        const sf::Texture& texture = mTextures.get(data.explosionTexture);
+        sf::Time timePerFrame = data.explosionDuration / static_cast<float>(data.explosionFrames);
+        int frame = std::min(static_cast<int>(mExplosionTime / timePerFrame), data.explosionFrames - 1);
+        int columns = std::max(1, static_cast<int>(texture.getSize().x) / data.explosionFrameSize.x);
+        sf::Vector2i size = data.explosionFrameSize;
+
+        sf::Sprite explosion(texture, sf::IntRect((frame % columns) * size.x, (frame / columns) * size.y, size.x, size.y));
+        Utility::centerOrigin(explosion);
+        target.draw(explosion, states);
     }
     else {
         target.draw(mSprite, states);
@@ -219,11 +226,13 @@ void Aircraft::updateCurrent(sf::Time dt, CommandQueue& commands) {
 
     if (isDestroyed()) {
         checkPickupDrop(commands);
-        mExplosion.update(dt);
+        mExplosionTime += dt;
+        if (mExplosionTime >= AircraftTable[mType].explosionDuration)
+            SceneNode::setLifecycle(MarkedForRemoval);
 
         if (!mPlayedExplosionSound) {
             SoundEffect::ID soundEffect = (Utility::randomInt(2) == 2) ? SoundEffect::Explosion1 : SoundEffect::Explosion2;
-            playLocalSound(commands, soundEffect);
+            playLocalSound(soundEffect);
 
             mPlayedExplosionSound = true;
         }
@@ -237,26 +246,28 @@ void Aircraft::updateCurrent(sf::Time dt, CommandQueue& commands) {
     
 }
 
-unsigned int Aircraft::getCategory() const {
-    if (isAllied()) {
-        return Category::PlayerAircraft;
-    }
-    else {
-        return Category::EnemyAircraft;
-    }
+void Aircraft::onDestroy() {
+    // Stays in the scene until the explosion has played
+    SceneNode::setLifecycle(mShowExplosion ? Destroyed : MarkedForRemoval);
+    updateTextNodes();
 }
 
-sf::FloatRect Aircraft::getBoundingRect() const {
+sf::FloatRect Aircraft::computeBoundingRect() const {
     return SceneNode::getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
-bool Aircraft::isMarkedForRemoval() const {
-    return isDestroyed() && (mExplosion.isFinished() || !mShowExplosion);
+const sf::Sprite* Aircraft::getCollisionSprite() const {
+    return &mSprite;
 }
 
 void Aircraft::remove() {
-    Entity::remove();
     mShowExplosion = false;
+    Entity::remove();
+    SceneNode::setLifecycle(MarkedForRemoval);
+}
+
+Aircraft::Type Aircraft::getAircraftType() const {
+    return mType;
 }
 
 bool Aircraft::isAllied() const {
@@ -281,6 +292,7 @@ void Aircraft::increaseSpread() {
 
 void Aircraft::collectMissiles(unsigned int count) {
     mMissileAmmo += count;
+    updateTextNodes();
 }
 
 void Aircraft::fire() {
@@ -293,19 +305,12 @@ void Aircraft::launchMissile() {
     if (mMissileAmmo > 0) {
         mIsLaunchingMissile = true;
         --mMissileAmmo;
+        updateTextNodes();
     }
 }
-void Aircraft::playLocalSound(CommandQueue& commands, SoundEffect::ID effect) {
-    sf::Vector2f worldPosition = SceneNode::getWorldPosition();
-
-    Command command;
-    command.category = Category::SoundEffect;
-    command.action = derivedAction<SoundNode>(
-        [effect, worldPosition] (SoundNode& node, sf::Time)
-        {
-            node.playSound(effect, worldPosition);
-        });
-    commands.push(command);
+
+void Aircraft::playLocalSound(SoundEffect::ID effect) {
+    mSounds.push(effect, SceneNode::getWorldPosition());
 }
 
 void Aircraft::updateMovementPattern(sf::Time dt) {
@@ -328,7 +333,13 @@ void Aircraft::updateMovementPattern(sf::Time dt) {
 
 void Aircraft::checkPickupDrop(CommandQueue& commands) {
     if ((!isAllied()) && (Utility::randomInt(3) == 0) && !mSpawnedPickup) {
-        commands.push(mDropPickupCommand);
+        Command dropPickup;
+        dropPickup.category = Category::SceneAirLayer;
+        dropPickup.origin = "Aircraft drop pickup";
+        dropPickup.action = [this] (SceneNode& node, sf::Time) {
+            createPickup(node);
+        };
+        commands.push(std::move(dropPickup));
     }
 
     mSpawnedPickup = true;
@@ -340,8 +351,14 @@ void Aircraft::checkProjectileLaunch(sf::Time dt, CommandQueue& commands) {
     }
     
     if (mIsFiring && (mFireCountdown <= sf::Time::Zero)) {
-        commands.push(mFireCommand);
-        playLocalSound(commands, isAllied() ? SoundEffect::AlliedGunfire : SoundEffect::EnemyGunfire);
+        Command fireCommand;
+        fireCommand.category = Category::BulletSystem;
+        fireCommand.origin = "Aircraft::fire";
+        fireCommand.action = derivedAction<BulletNode>([this] (BulletNode& bullets, sf::Time) {
+            createBullets(bullets);
+        });
+        commands.push(std::move(fireCommand));
+        playLocalSound(isAllied() ? SoundEffect::AlliedGunfire : SoundEffect::EnemyGunfire);
 
         mFireCountdown += AircraftTable[mType].fireInterval / (mFireRateLevel + 1.f);
         mIsFiring = false;
@@ -352,33 +369,49 @@ void Aircraft::checkProjectileLaunch(sf::Time dt, CommandQueue& commands) {
     }
 
     if (mIsLaunchingMissile) {
-        commands.push(mMissileCommand);
-        playLocalSound(commands, SoundEffect::LaunchMissile);
+        Command missileCommand;
+        missileCommand.category = Category::SceneAirLayer;
+        missileCommand.origin = "Aircraft::launchMissile";
+        missileCommand.action = [this] (SceneNode& node, sf::Time) {
+            createProjectile(node, Projectile::Missile, 0.f, 0.5f);
+        };
+        commands.push(std::move(missileCommand));
+        playLocalSound(SoundEffect::LaunchMissile);
         mIsLaunchingMissile = false;
     }
 }
 
-void Aircraft::createBullets(SceneNode& node, const TextureHolder& textures) const {
+void Aircraft::createBullets(BulletNode& bullets) const {
     Projectile::Type type = isAllied() ? Projectile::AlliedBullet : Projectile::EnemyBullet;
+    if (bullets.getProjectileType() != type)
+        return;
 
     switch (mSpreadLevel) {
         case 1:
-            createProjectile(node, type, 0.0f, 0.5f, textures);
+            createBullet(bullets, 0.0f, 0.5f);
             break;
         case 2:
-            createProjectile(node, type, -0.33f, 0.33f, textures);
-            createProjectile(node, type, 0.33f, 0.33f, textures);
+            createBullet(bullets, -0.33f, 0.33f);
+            createBullet(bullets, 0.33f, 0.33f);
             break;
         case 3:
-            createProjectile(node, type, -0.5f, 0.33f, textures);
-            createProjectile(node, type, 0.0f, 0.5f, textures);
-            createProjectile(node, type, 0.5f, 0.33f, textures);
+            createBullet(bullets, -0.5f, 0.33f);
+            createBullet(bullets, 0.0f, 0.5f);
+            createBullet(bullets, 0.5f, 0.33f);
             break;
     }
 }
 
-void Aircraft::createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset, const TextureHolder& textures) const {
-    std::unique_ptr<Projectile> projectile(new Projectile(type, textures));
+void Aircraft::createBullet(BulletNode& bullets, float xOffset, float yOffset) const {
+    sf::Vector2f offset(xOffset * mSprite.getGlobalBounds().width, yOffset * mSprite.getGlobalBounds().height);
+    sf::Vector2f velocity(0, bullets.getMaxSpeed());
+
+    float sign = isAllied() ? -1.f : 1.f;
+    bullets.spawn(SceneNode::getWorldPosition() + offset * sign, velocity * sign);
+}
+
+void Aircraft::createProjectile(SceneNode& node, Projectile::Type type, float xOffset, float yOffset) const {
+    NodePool<Projectile>::Ptr projectile = NodePool<Projectile>::create(type, mTextures);
 
     sf::Vector2f offset(xOffset * mSprite.getGlobalBounds().width, yOffset * mSprite.getGlobalBounds().height);
     sf::Vector2f velocity(0, projectile->getMaxSpeed());
@@ -389,31 +422,62 @@ void Aircraft::createProjectile(SceneNode& node, Projectile::Type type, float xO
     node.attachChild(std::move(projectile));
 }
 
-void Aircraft::createPickup(SceneNode& node, const TextureHolder& textures) const {
+void Aircraft::createPickup(SceneNode& node) const {
     auto type = static_cast<Pickup::Type>(Utility::randomInt(Pickup::TypeCount));
 
-    std::unique_ptr<Pickup> pickup(new Pickup(type, textures));
+    NodePool<Pickup>::Ptr pickup = NodePool<Pickup>::create(type, mTextures);
     pickup->setPosition(SceneNode::getWorldPosition());
     pickup->setVelocity(0.f, 1.f);
     node.attachChild(std::move(pickup));
 }
 
 void Aircraft::updateText() {
-    if (Entity::isDestroyed()) {
-        mHealthDisplay->setString("");
+    // Strings are only rebuilt when the number changes
+    if (mHealthDisplay) {
+        int hitpoints = Entity::getHitpoints();
+        if (hitpoints != mDisplayedHitpoints) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "%d HP", hitpoints);
+            mHealthDisplay->setString(text);
+            mDisplayedHitpoints = hitpoints;
+        }
+        mHealthDisplay->setPosition(0.f, 50.f);
+        mHealthDisplay->setRotation(-SceneNode::getRotation());
     }
-    else {
-        mHealthDisplay->setString(std::to_string(Entity::getHitpoints()) + " HP");
+
+    if (mMissileDisplay && mMissileAmmo != mDisplayedAmmo) {
+        char text[16];
+        std::snprintf(text, sizeof(text), "M: %d", mMissileAmmo);
+        mMissileDisplay->setString(text);
+        mDisplayedAmmo = mMissileAmmo;
     }
-    mHealthDisplay->setPosition(0.f, 50.f);
-    mHealthDisplay->setRotation(-sf::Transformable::getRotation());
-    if (mMissileDisplay) {
-        if (mMissileAmmo == 0 || Entity::isDestroyed()) {
-            mMissileDisplay->setString("");
-        }
-        else {
-            mMissileDisplay->setString("M: " + std::to_string(mMissileAmmo));
-        }
+}
+
+void Aircraft::updateTextNodes() {
+    // Only called on state changes outside the scene update, detaching there would free nodes the scan still visits
+    bool showHealth = !Entity::isDestroyed();
+    if (showHealth && !mHealthDisplay) {
+        NodePool<TextNode>::Ptr healthDisplay = NodePool<TextNode>::create(mFonts, "");
+        mHealthDisplay = healthDisplay.get();
+        mDisplayedHitpoints = -1;
+        SceneNode::attachChild(std::move(healthDisplay));
+    }
+    else if (!showHealth && mHealthDisplay) {
+        SceneNode::detachChild(*mHealthDisplay);
+        mHealthDisplay = nullptr;
+    }
+
+    bool showAmmo = isAllied() && mMissileAmmo > 0 && !Entity::isDestroyed();
+    if (showAmmo && !mMissileDisplay) {
+        NodePool<TextNode>::Ptr missileDisplay = NodePool<TextNode>::create(mFonts, "");
+        missileDisplay->setPosition(0, 70);
+        mMissileDisplay = missileDisplay.get();
+        mDisplayedAmmo = -1;
+        SceneNode::attachChild(std::move(missileDisplay));
+    }
+    else if (!showAmmo && mMissileDisplay) {
+        SceneNode::detachChild(*mMissileDisplay);
+        mMissileDisplay = nullptr;
     }
 }
 
@@ -427,6 +491,9 @@ void Aircraft::updateRollAnimation() {
         else if (Entity::getVelocity().x > 0.f) {
             textureRect.left += 2 * textureRect.width;
         }
-        mSprite.setTextureRect(textureRect);
+        if (textureRect != mSprite.getTextureRect()) {
+            mSprite.setTextureRect(textureRect);
+            SceneNode::markBoundsDirty();
+        }
     }
 }
\ No newline at end of file
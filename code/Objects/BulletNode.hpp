@@ -0,0 +1,298 @@
+#pragma once
+
+#include "Objects/SceneNode.hpp"
+#include "Objects/Projectile.hpp"
+#include "Utils/RectBatch.hpp"
+#include "Utils/ResourceIdentifiers.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// Every bullet of one type, kept as parallel arrays and drawn as a single vertex array.
+// Each update sorts the bullets into horizontal bands, so a hit query only walks the bands it reaches.
+class BulletNode : public SceneNode {
+    public:
+        BulletNode(Projectile::Type type, const TextureHolder& textures);
+        void spawn(sf::Vector2f position, sf::Vector2f velocity);
+        void kill(std::size_t index);
+        void cull(const sf::FloatRect& bounds);
+
+        template <typename Function>
+        void findHits(const sf::FloatRect& rect, Function fn) const;
+
+        Projectile::Type getProjectileType() const;
+        const sf::Sprite& getSprite() const;
+        sf::Vector2f getBulletPosition(std::size_t index) const;
+        sf::FloatRect getBulletBounds(std::size_t index) const;
+        float getMaxSpeed() const;
+        int getDamage() const;
+        std::size_t getBulletCount() const;
+        static std::size_t getBytesPerBullet();
+    private:
+        virtual std::size_t getNodeSize() const;
+        virtual bool isUnbounded() const;
+        virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
+        virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+        void removeDeadBullets();
+        void sortIntoBands();
+        void permute(std::vector<float>& lane);
+        std::size_t getBand(float y) const;
+        void computeVertices() const;
+    private:
+        static const int BandHeight = 64;
+    private:
+        Projectile::Type mType;
+        sf::Sprite mSprite;
+        sf::Vector2f mHalfSize;
+        std::vector<float> mPositionsX;
+        std::vector<float> mPositionsY;
+        std::vector<float> mVelocitiesX;
+        std::vector<float> mVelocitiesY;
+        std::vector<sf::Uint8> mAlive;
+        RectBatch mBounds;
+        std::vector<std::size_t> mBandStarts;
+        std::vector<std::uint32_t> mOrder;
+        std::vector<float> mScratch;
+        float mBandsTop;
+        float mReach;
+        std::size_t mBandedCount;
+        mutable sf::VertexArray mVertexArray;
+        mutable bool mNeedsVertexUpdate;
+};
+
+BulletNode::BulletNode(Projectile::Type type, const TextureHolder& textures)
+: SceneNode(Category::BulletSystem), mType(type), mSprite(textures.get(ProjectileTable[type].texture), ProjectileTable[type].textureRect), mHalfSize(), 
+mPositionsX(), mPositionsY(), mVelocitiesX(), mVelocitiesY(), mAlive(), mBounds(), mBandStarts(), mOrder(), mScratch(), mBandsTop(0.f), mReach(0.f),
+mBandedCount(0), mVertexArray(sf::Quads), mNeedsVertexUpdate(true) {
+    // Guided missiles need steering and emitters, they stay projectile nodes
+    assert(type != Projectile::Missile);
+
+    Utility::centerOrigin(mSprite);
+    mHalfSize = sf::Vector2f(ProjectileTable[type].textureRect.width / 2.f, ProjectileTable[type].textureRect.height / 2.f);
+}
+
+void BulletNode::spawn(sf::Vector2f position, sf::Vector2f velocity) {
+    mPositionsX.push_back(position.x);
+    mPositionsY.push_back(position.y);
+    mVelocitiesX.push_back(velocity.x);
+    mVelocitiesY.push_back(velocity.y);
+    mAlive.push_back(1);
+
+    // Hittable in the same tick, like a projectile node attached by a command
+    mBounds.push(getBulletBounds(mAlive.size() - 1));
+    mNeedsVertexUpdate = true;
+}
+
+void BulletNode::kill(std::size_t index) {
+    mAlive[index] = 0;
+    mNeedsVertexUpdate = true;
+}
+
+void BulletNode::cull(const sf::FloatRect& bounds) {
+    float right = bounds.left + bounds.width;
+    float bottom = bounds.top + bounds.height;
+
+    for (std::size_t i = 0; i < mAlive.size(); ++i) {
+        bool inside = mPositionsX[i] + mHalfSize.x > bounds.left && mPositionsX[i] - mHalfSize.x < right
+                   && mPositionsY[i] + mHalfSize.y > bounds.top && mPositionsY[i] - mHalfSize.y < bottom;
+        mAlive[i] &= static_cast<sf::Uint8>(inside);
+    }
+}
+
+template <typename Function>
+void BulletNode::findHits(const sf::FloatRect& rect, Function fn) const {
+    // Bounds are swept over the last step, so fast bullets cannot pass through
+    auto hit = [&] (std::size_t index) {
+        if (mAlive[index])
+            fn(index);
+    };
+
+    // A bullet can only hit when its centre lies within its reach of the rect
+    if (!mBandStarts.empty()) {
+        std::size_t bands = mBandStarts.size() - 1;
+        float top = rect.top - mReach - mBandsTop;
+        float bottom = rect.top + rect.height + mReach - mBandsTop;
+
+        if (bottom >= 0.f && top < static_cast<float>(bands * BandHeight)) {
+            std::size_t first = (top > 0.f) ? getBand(rect.top - mReach) : 0;
+            std::size_t last = std::min(bands - 1, getBand(rect.top + rect.height + mReach));
+            mBounds.intersect(rect, mBandStarts[first], mBandStarts[last + 1], hit);
+        }
+    }
+
+    // Bullets spawned since the last update are not banded yet
+    mBounds.intersect(rect, mBandedCount, mBounds.size(), hit);
+}
+
+Projectile::Type BulletNode::getProjectileType() const {
+    return mType;
+}
+
+const sf::Sprite& BulletNode::getSprite() const {
+    return mSprite;
+}
+
+sf::Vector2f BulletNode::getBulletPosition(std::size_t index) const {
+    return sf::Vector2f(mPositionsX[index], mPositionsY[index]);
+}
+
+sf::FloatRect BulletNode::getBulletBounds(std::size_t index) const {
+    return sf::FloatRect(mPositionsX[index] - mHalfSize.x, mPositionsY[index] - mHalfSize.y, 2.f * mHalfSize.x, 2.f * mHalfSize.y);
+}
+
+float BulletNode::getMaxSpeed() const {
+    return ProjectileTable[mType].speed;
+}
+
+int BulletNode::getDamage() const {
+    return ProjectileTable[mType].damage;
+}
+
+std::size_t BulletNode::getBulletCount() const {
+    return mAlive.size();
+}
+
+std::size_t BulletNode::getBytesPerBullet() {
+    // Four state lanes, the alive flag, four bounds lanes, the band sort's index and scratch lanes and one quad
+    return 9 * sizeof(float) + sizeof(sf::Uint8) + sizeof(std::uint32_t) + 4 * sizeof(sf::Vertex);
+}
+
+std::size_t BulletNode::getNodeSize() const {
+    return sizeof(BulletNode);
+}
+
+bool BulletNode::isUnbounded() const {
+    // Bullets are spread over the whole battlefield, they are culled one by one instead
+    return true;
+}
+
+void BulletNode::updateCurrent(sf::Time dt, CommandQueue& commands) {
+    removeDeadBullets();
+
+    const float seconds = dt.asSeconds();
+    const std::size_t count = mAlive.size();
+
+    for (std::size_t i = 0; i < count; ++i)
+        mPositionsX[i] += mVelocitiesX[i] * seconds;
+    for (std::size_t i = 0; i < count; ++i)
+        mPositionsY[i] += mVelocitiesY[i] * seconds;
+
+    sortIntoBands();
+
+    mBounds.clear();
+    mReach = 0.f;
+    for (std::size_t i = 0; i < count; ++i) {
+        float stepX = mVelocitiesX[i] * seconds;
+        float stepY = mVelocitiesY[i] * seconds;
+        mReach = std::max(mReach, mHalfSize.y + std::abs(stepY));
+
+        float left = mPositionsX[i] - mHalfSize.x - std::max(stepX, 0.f);
+        float top = mPositionsY[i] - mHalfSize.y - std::max(stepY, 0.f);
+        float width = 2.f * mHalfSize.x + std::abs(stepX);
+        float height = 2.f * mHalfSize.y + std::abs(stepY);
+        mBounds.push(sf::FloatRect(left, top, width, height));
+    }
+
+    mNeedsVertexUpdate = true;
+}
+
+void BulletNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (mNeedsVertexUpdate) {
+        computeVertices();
+        mNeedsVertexUpdate = false;
+    }
+
+    // Positions are in world coordinates, the air layer sits at the origin
+    states.texture = mSprite.getTexture();
+    target.draw(mVertexArray, states);
+}
+
+void BulletNode::removeDeadBullets() {
+    // Swap and pop, bullet order carries no meaning
+    for (std::size_t i = 0; i < mAlive.size();) {
+        if (mAlive[i]) {
+            ++i;
+            continue;
+        }
+
+        mPositionsX[i] = mPositionsX.back();
+        mPositionsY[i] = mPositionsY.back();
+        mVelocitiesX[i] = mVelocitiesX.back();
+        mVelocitiesY[i] = mVelocitiesY.back();
+        mAlive[i] = mAlive.back();
+
+        mPositionsX.pop_back();
+        mPositionsY.pop_back();
+        mVelocitiesX.pop_back();
+        mVelocitiesY.pop_back();
+        mAlive.pop_back();
+    }
+}
+
+void BulletNode::sortIntoBands() {
+    // Counting sort on the band of each centre, linear in the bullet count. Runs right after
+    // removeDeadBullets, so every bullet is alive and the alive flags need no reordering.
+    const std::size_t count = mAlive.size();
+    mBandStarts.clear();
+    mBandedCount = count;
+    if (count == 0)
+        return;
+
+    auto extent = std::minmax_element(mPositionsY.begin(), mPositionsY.end());
+    mBandsTop = *extent.first;
+    std::size_t bands = getBand(*extent.second) + 1;
+
+    // Bullets per band, shifted by one so the running sum gives where each band starts
+    mBandStarts.assign(bands + 1, 0);
+    for (std::size_t i = 0; i < count; ++i)
+        ++mBandStarts[getBand(mPositionsY[i]) + 1];
+    for (std::size_t band = 1; band <= bands; ++band)
+        mBandStarts[band] += mBandStarts[band - 1];
+
+    // Placing a bullet moves its band's start up, afterwards every start sits on the next band
+    mOrder.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        mOrder[mBandStarts[getBand(mPositionsY[i])]++] = static_cast<std::uint32_t>(i);
+    for (std::size_t band = bands - 1; band > 0; --band)
+        mBandStarts[band] = mBandStarts[band - 1];
+    mBandStarts[0] = 0;
+
+    permute(mPositionsX);
+    permute(mPositionsY);
+    permute(mVelocitiesX);
+    permute(mVelocitiesY);
+}
+
+void BulletNode::permute(std::vector<float>& lane) {
+    mScratch.resize(lane.size());
+    for (std::size_t i = 0; i < lane.size(); ++i)
+        mScratch[i] = lane[mOrder[i]];
+
+    lane.swap(mScratch);
+}
+
+std::size_t BulletNode::getBand(float y) const {
+    return static_cast<std::size_t>((y - mBandsTop) / BandHeight);
+}
+
+void BulletNode::computeVertices() const {
+    sf::FloatRect textureRect(mSprite.getTextureRect());
+    float textureRight = textureRect.left + textureRect.width;
+    float textureBottom = textureRect.top + textureRect.height;
+
+    // Dead bullets keep their slot until the next update, they are drawn as empty quads
+    mVertexArray.resize(mAlive.size() * 4);
+    for (std::size_t i = 0; i < mAlive.size(); ++i) {
+        float halfX = mAlive[i] ? mHalfSize.x : 0.f;
+        float halfY = mAlive[i] ? mHalfSize.y : 0.f;
+        float x = mPositionsX[i];
+        float y = mPositionsY[i];
+
+        sf::Vertex* quad = &mVertexArray[i * 4];
+        quad[0] = sf::Vertex(sf::Vector2f(x - halfX, y - halfY), sf::Vector2f(textureRect.left, textureRect.top));
+        quad[1] = sf::Vertex(sf::Vector2f(x + halfX, y - halfY), sf::Vector2f(textureRight, textureRect.top));
+        quad[2] = sf::Vertex(sf::Vector2f(x + halfX, y + halfY), sf::Vector2f(textureRight, textureBottom));
+        quad[3] = sf::Vertex(sf::Vector2f(x - halfX, y + halfY), sf::Vector2f(textureRect.left, textureBottom));
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Objects/SceneNode.hpp"
+
+#include <vector>
+#include <algorithm>
+
+class ContactManager : private sf::NonCopyable {
+    public:
+        enum State {
+            Begin,
+            Stay,
+            End
+        };
+
+        struct Contact {
+            SceneNode::Pair pair;
+            State state;
+        };
+    public:
+        ContactManager();
+        void beginUpdate();
+        void add(SceneNode& first, SceneNode& second);
+        void endUpdate();
+        void removeWrecks();
+        const std::vector<Contact>& getContacts() const;
+    private:
+        std::vector<SceneNode::Pair> mCurrent;
+        std::vector<SceneNode::Pair> mPrevious;
+        std::vector<Contact> mContacts;
+};
+
+ContactManager::ContactManager()
+: mCurrent(), mPrevious(), mContacts() {
+}
+
+void ContactManager::beginUpdate() {
+    // Buffers are swapped, not reallocated, so a steady contact count costs no allocation
+    mPrevious.swap(mCurrent);
+    mCurrent.clear();
+}
+
+void ContactManager::add(SceneNode& first, SceneNode& second) {
+    mCurrent.emplace_back(&first, &second);
+}
+
+void ContactManager::endUpdate() {
+    std::sort(mCurrent.begin(), mCurrent.end());
+    mCurrent.erase(std::unique(mCurrent.begin(), mCurrent.end()), mCurrent.end());
+
+    mContacts.clear();
+    auto current = mCurrent.begin();
+    auto previous = mPrevious.begin();
+
+    while (current != mCurrent.end() || previous != mPrevious.end()) {
+        if (previous == mPrevious.end() || (current != mCurrent.end() && *current < *previous)) {
+            mContacts.push_back(Contact{*current++, Begin});
+        }
+        else if (current == mCurrent.end() || *previous < *current) {
+            mContacts.push_back(Contact{*previous++, End});
+        }
+        else {
+            mContacts.push_back(Contact{*current++, Stay});
+            ++previous;
+        }
+    }
+}
+
+void ContactManager::removeWrecks() {
+    // Nodes about to be freed must not reach next frame's End events
+    mCurrent.erase(std::remove_if(mCurrent.begin(), mCurrent.end(), [] (const SceneNode::Pair& pair) {
+        return pair.first->isMarkedForRemoval() || pair.second->isMarkedForRemoval();
+    }), mCurrent.end());
+}
+
+const std::vector<ContactManager::Contact>& ContactManager::getContacts() const {
+    return mContacts;
+}
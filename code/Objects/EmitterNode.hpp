@@ -6,7 +6,11 @@ class EmitterNode : public SceneNode {
 
     public:
         explicit EmitterNode(Particle::Type type);
+        Particle::Type getParticleType() const;
+        bool hasParticleSystem() const;
+        void setParticleSystem(ParticleNode& system);
     private:
+        virtual std::size_t getNodeSize() const;
         virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
         void emitParticles(sf::Time dt);
     private:
@@ -16,26 +20,32 @@ class EmitterNode : public SceneNode {
 };
 
 EmitterNode::EmitterNode(Particle::Type type) 
-: SceneNode(), mAccumulatedTime(sf::Time::Zero), mType(type), mParticleSystem(nullptr) {
+: SceneNode(Category::ParticleEmitter), mAccumulatedTime(sf::Time::Zero), mType(type), mParticleSystem(nullptr) {
+}
+
+Particle::Type EmitterNode::getParticleType() const {
+    return mType;
+}
+
+bool EmitterNode::hasParticleSystem() const {
+    return mParticleSystem != nullptr;
+}
+
+void EmitterNode::setParticleSystem(ParticleNode& system) {
+    assert(system.getParticleType() == mType);
+    mParticleSystem = &system;
+}
+
+std::size_t EmitterNode::getNodeSize() const {
+    return sizeof(EmitterNode);
 }
 
 void EmitterNode::updateCurrent(sf::Time dt, CommandQueue& commands) 
 {
+   // The world hands over the particle system when the emitter spawns
    if (mParticleSystem) {
        emitParticles(dt);
    }
-   else {
-       auto finder = [this] (ParticleNode& container, sf::Time) {
-           if (container.getParticleType() == mType) {
-               mParticleSystem = &container;
-           }
-       };
-
-       Command command;
-       command.category = Category::ParticleSystem;
-       command.action = derivedAction<ParticleNode>(finder);
-       commands.push(command);
-   }
 }
 
 void EmitterNode::emitParticles(sf::Time dt) {
@@ -4,27 +4,31 @@
 
 class Entity : public SceneNode {
     public:
-        explicit Entity(int hitpoints);
+        Entity(int hitpoints, Category::Type category);
         void setVelocity(sf::Vector2f velocity);
         void setVelocity(float vx, float vy);
         void accelerate(sf::Vector2f velocity);
         void accelerate(float vx, float vy);
         sf::Vector2f getVelocity() const;
+        sf::Vector2f getPreviousPosition() const;
         int getHitpoints() const;
         void repair(int points);
         void damage(int points);
         void destroy();
         virtual void remove();
-        virtual bool isDestroyed() const;
     protected:
         virtual void updateCurrent(sf::Time dt, CommandQueue&);
+        virtual void onDestroy();
+    private:
+        void checkHitpoints();
     private:
         sf::Vector2f mVelocity;
+        sf::Vector2f mPreviousPosition;
         int mHitpoints;
 };
 
-Entity::Entity(int hitpoints) 
-: mVelocity(), mHitpoints(hitpoints) {
+Entity::Entity(int hitpoints, Category::Type category) 
+: SceneNode(category), mVelocity(), mPreviousPosition(), mHitpoints(hitpoints) {
 }
 
 void Entity::setVelocity(sf::Vector2f velocity) {
@@ -48,6 +52,10 @@ sf::Vector2f Entity::getVelocity() const {
     return mVelocity;
 }
 
+sf::Vector2f Entity::getPreviousPosition() const {
+    return mPreviousPosition;
+}
+
 int Entity::getHitpoints() const {
     return mHitpoints;
 }
@@ -60,20 +68,28 @@ void Entity::repair(int points) {
 void Entity::damage(int points) {
     assert(points > 0);
     mHitpoints -= points;
+    checkHitpoints();
 }
 
 void Entity::destroy() {
     mHitpoints = 0;
+    checkHitpoints();
 }
 
 void Entity::remove() {
     destroy();
 }
 
-bool Entity::isDestroyed() const {
-    return mHitpoints <= 0;
+void Entity::updateCurrent(sf::Time dt, CommandQueue&) {
+    mPreviousPosition = SceneNode::getPosition();
+    SceneNode::move(mVelocity * dt.asSeconds());
 }
 
-void Entity::updateCurrent(sf::Time dt, CommandQueue&) {
-    sf::Transformable::move(mVelocity * dt.asSeconds());
+void Entity::onDestroy() {
+    SceneNode::setLifecycle(MarkedForRemoval);
+}
+
+void Entity::checkHitpoints() {
+    if (mHitpoints <= 0 && SceneNode::getLifecycle() == Alive)
+        onDestroy();
 }
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Objects/SceneNode.hpp"
+
+#include <SFML/System.hpp>
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <ostream>
+
+// Slab allocator for one node type, freed slots are reused before a new slab is added
+template <typename T>
+class NodePool : private sf::NonCopyable {
+    public:
+        typedef std::unique_ptr<T, NodeDeleter> Ptr;
+
+        struct Stats {
+            std::size_t live;
+            std::size_t highWaterMark;
+            std::size_t capacity;
+        };
+    public:
+        static NodePool& instance();
+
+        template <typename... Args>
+        static Ptr create(Args&&... args);
+
+        Stats getStats() const;
+        void report(std::ostream& stream, const char* name) const;
+    private:
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+    private:
+        NodePool();
+        void* allocate();
+        void deallocate(void* slot);
+        void addSlab();
+        static void release(SceneNode* node);
+    private:
+        static const std::size_t SlabSize = 64;
+    private:
+        std::vector<std::unique_ptr<Slot[]>> mSlabs;
+        std::vector<Slot*> mFreeSlots;
+        std::size_t mLive;
+        std::size_t mHighWaterMark;
+};
+
+template <typename T>
+NodePool<T>::NodePool()
+: mSlabs(), mFreeSlots(), mLive(0), mHighWaterMark(0) {
+}
+
+template <typename T>
+NodePool<T>& NodePool<T>::instance() {
+    static NodePool pool;
+    return pool;
+}
+
+template <typename T>
+template <typename... Args>
+typename NodePool<T>::Ptr NodePool<T>::create(Args&&... args) {
+    NodePool& pool = instance();
+    void* slot = pool.allocate();
+
+    try {
+        return Ptr(new (slot) T(std::forward<Args>(args)...), NodeDeleter(&NodePool::release));
+    }
+    catch (...) {
+        pool.deallocate(slot);
+        throw;
+    }
+}
+
+template <typename T>
+typename NodePool<T>::Stats NodePool<T>::getStats() const {
+    return Stats{mLive, mHighWaterMark, mSlabs.size() * SlabSize};
+}
+
+template <typename T>
+void NodePool<T>::report(std::ostream& stream, const char* name) const {
+    Stats stats = getStats();
+    stream << name << " pool: " << stats.live << " live, " << stats.highWaterMark << " peak, " << stats.capacity << " slots\n";
+}
+
+template <typename T>
+void* NodePool<T>::allocate() {
+    if (mFreeSlots.empty())
+        addSlab();
+
+    Slot* slot = mFreeSlots.back();
+    mFreeSlots.pop_back();
+
+    mHighWaterMark = std::max(mHighWaterMark, ++mLive);
+    return slot;
+}
+
+template <typename T>
+void NodePool<T>::deallocate(void* slot) {
+    mFreeSlots.push_back(static_cast<Slot*>(slot));
+    --mLive;
+}
+
+template <typename T>
+void NodePool<T>::addSlab() {
+    mSlabs.emplace_back(new Slot[SlabSize]);
+    mFreeSlots.reserve(mSlabs.size() * SlabSize);
+
+    // Pushed in reverse so slots are handed out in address order
+    Slot* slab = mSlabs.back().get();
+    for (std::size_t i = SlabSize; i > 0; --i)
+        mFreeSlots.push_back(&slab[i - 1]);
+}
+
+template <typename T>
+void NodePool<T>::release(SceneNode* node) {
+    // Only nodes created by this pool carry this deleter, so the dynamic type is exactly T
+    T* object = static_cast<T*>(node);
+    object->~T();
+    instance().deallocate(object);
+}
@@ -13,8 +13,9 @@ class ParticleNode : public SceneNode {
         ParticleNode(Particle::Type type, const TextureHolder& textures);
         void addParticle(sf::Vector2f position);
         Particle::Type getParticleType() const;
-        virtual unsigned int getCategory() const;
     private:
+        virtual std::size_t getNodeSize() const;
+        virtual bool isUnbounded() const;
         virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
         virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
         void addVertex(float worldX, float worldY, float texCoordX, float texCoordY, const sf::Color& color) const;
@@ -28,7 +29,7 @@ class ParticleNode : public SceneNode {
 };
 
 ParticleNode::ParticleNode(Particle::Type type, const TextureHolder& textures) 
-: SceneNode(), mParticles(), mTexture(textures.get(Textures::Particle)), mType(type), mVertexArray(sf::Quads), mNeedsVertexUpdate(true) {
+: SceneNode(Category::ParticleSystem), mParticles(), mTexture(textures.get(Textures::Particle)), mType(type), mVertexArray(sf::Quads), mNeedsVertexUpdate(true) {
 
 }
 
@@ -44,8 +45,13 @@ Particle::Type ParticleNode::getParticleType() const {
     return mType;
 }
 
-unsigned int ParticleNode::getCategory() const {
-    return Category::ParticleSystem;
+std::size_t ParticleNode::getNodeSize() const {
+    return sizeof(ParticleNode);
+}
+
+bool ParticleNode::isUnbounded() const {
+    // Particles are drawn in world coordinates wherever they were emitted
+    return true;
 }
 
 void ParticleNode::updateCurrent(sf::Time dt, CommandQueue& commands) {
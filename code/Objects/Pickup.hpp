@@ -31,11 +31,13 @@ class Pickup : public Entity {
         };
     public:
         Pickup(Type type, const TextureHolder& textures);
-        virtual unsigned int getCategory() const;
-        virtual sf::FloatRect getBoundingRect() const;
+        virtual const sf::Sprite* getCollisionSprite() const;
         void apply(Aircraft& player) const;
     protected:
         virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+    private:
+        virtual std::size_t getNodeSize() const;
+        virtual sf::FloatRect computeBoundingRect() const;
     private:
         Type mType;
         sf::Sprite mSprite;
@@ -44,18 +46,22 @@ class Pickup : public Entity {
 
 
 Pickup::Pickup(Type type, const TextureHolder& textures) 
-: Entity(1), mType(type), mSprite(textures.get(PickupTable[type].texture), PickupTable[type].textureRect) {
+: Entity(1, Category::Pickup), mType(type), mSprite(textures.get(PickupTable[type].texture), PickupTable[type].textureRect) {
     Utility::centerOrigin(mSprite);
 }
 
-unsigned int Pickup::getCategory() const {
-    return Category::Pickup;
+std::size_t Pickup::getNodeSize() const {
+    return sizeof(Pickup);
 }
 
-sf::FloatRect Pickup::getBoundingRect() const {
+sf::FloatRect Pickup::computeBoundingRect() const {
     return SceneNode::getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
+const sf::Sprite* Pickup::getCollisionSprite() const {
+    return &mSprite;
+}
+
 void Pickup::apply(Aircraft& player) const {
     PickupTable[mType].action(player);
 }
@@ -2,6 +2,7 @@
 
 #include "Objects/Entity.hpp"
 #include "Objects/EmitterNode.hpp"
+#include "Objects/NodePool.hpp"
 #include "Utils/ResourceIdentifiers.hpp"
 #include "Utils/Utility.hpp"
 
@@ -30,17 +31,20 @@ class Projectile : public Entity {
         Projectile(Type type, const TextureHolder& textures);
         void guideTowards(sf::Vector2f position);
         bool isGuided() const;
-        virtual unsigned int getCategory() const;
-        virtual sf::FloatRect getBoundingRect() const;
+        virtual const sf::Sprite* getCollisionSprite() const;
+        virtual sf::Vector2f getSweep() const;
         float getMaxSpeed() const;
         int getDamage() const;
     private:
+        virtual std::size_t getNodeSize() const;
         virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
         virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
+        virtual sf::FloatRect computeBoundingRect() const;
     private:
         Type mType;
         sf::Sprite mSprite;
         sf::Vector2f mTargetDirection;
+        bool mHasMoved;
 };
 
 std::vector<ProjectileData> initializeProjectileData() {
@@ -65,15 +69,15 @@ std::vector<ProjectileData> initializeProjectileData() {
 }
 
 Projectile::Projectile(Type type, const TextureHolder& textures) 
-: Entity(1), mType(type), mSprite(textures.get(ProjectileTable[type].texture), ProjectileTable[type].textureRect), mTargetDirection() {
+: Entity(1, (type == EnemyBullet) ? Category::EnemyProjectile : Category::AlliedProjectile), mType(type), mSprite(textures.get(ProjectileTable[type].texture), ProjectileTable[type].textureRect), mTargetDirection(), mHasMoved(false) {
     Utility::centerOrigin(mSprite);
 
     if (isGuided()) {
-        std::unique_ptr<EmitterNode> smoke(new EmitterNode(Particle::Smoke));
+        NodePool<EmitterNode>::Ptr smoke = NodePool<EmitterNode>::create(Particle::Smoke);
         smoke->setPosition(0.f, getBoundingRect().height / 2.f);
         SceneNode::attachChild(std::move(smoke));
 
-        std::unique_ptr<EmitterNode> propellant(new EmitterNode(Particle::Propellant));
+        NodePool<EmitterNode>::Ptr propellant = NodePool<EmitterNode>::create(Particle::Propellant);
         propellant->setPosition(0.f, getBoundingRect().height / 2.f);
         SceneNode::attachChild(std::move(propellant));
     }
@@ -88,17 +92,20 @@ bool Projectile::isGuided() const {
     return mType == Missile;
 }
 
-unsigned int Projectile::getCategory() const {
-    if (mType == EnemyBullet) {
-        return Category::EnemyProjectile;
-    }
-    else {
-        return Category::AlliedProjectile;
-    }
+sf::FloatRect Projectile::computeBoundingRect() const {
+    return SceneNode::getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
-sf::FloatRect Projectile::getBoundingRect() const {
-    return SceneNode::getWorldTransform().transformRect(mSprite.getGlobalBounds());
+const sf::Sprite* Projectile::getCollisionSprite() const {
+    return &mSprite;
+}
+
+sf::Vector2f Projectile::getSweep() const {
+    // Projectiles live directly in an air layer, so local movement is world movement
+    if (!mHasMoved)
+        return sf::Vector2f();
+
+    return SceneNode::getPosition() - Entity::getPreviousPosition();
 }
 
 float Projectile::getMaxSpeed() const {
@@ -109,6 +116,10 @@ int Projectile::getDamage() const {
     return ProjectileTable[mType].damage;
 }
 
+std::size_t Projectile::getNodeSize() const {
+    return sizeof(Projectile);
+}
+
 void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands) {
     if (isGuided()) {
         const float approachRate = 200.f;
@@ -117,11 +128,12 @@ void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands) {
         newVelocity *= getMaxSpeed();
         float angle = std::atan2(newVelocity.y, newVelocity.x);
 
-        Transformable::setRotation(Utility::toDegree(angle) + 90.f);
+        SceneNode::setRotation(Utility::toDegree(angle) + 90.f);
         Entity::setVelocity(newVelocity);
     }
 
     Entity::updateCurrent(dt, commands);
+    mHasMoved = true;
 }
 
 void Projectile::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const {
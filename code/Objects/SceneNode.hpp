@@ -2,7 +2,10 @@
 
 #include "Game/Category.hpp"
 #include "Game/Command.hpp"
+#include "Game/CommandQueue.hpp"
 #include "Utils/Utility.hpp"
+#include "Utils/CollisionMask.hpp"
+#include "Objects/SceneRegistry.hpp"
 
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
@@ -11,146 +14,512 @@
 #include <memory>
 #include <algorithm>
 #include <cassert>
-#include <set>
 
-class SceneNode : public sf::Transformable, public sf::Drawable, public sf::NonCopyable {
+class SceneNode;
+
+// Frees a node through its pool if it came from one, with delete otherwise
+struct NodeDeleter {
+    NodeDeleter();
+    explicit NodeDeleter(void (*release)(SceneNode*));
+
+    template <typename T>
+    NodeDeleter(const std::default_delete<T>&);
+
+    void operator() (SceneNode* node) const;
+
+    void (*release)(SceneNode*);
+};
+
+// sf::Transformable is private, so every change to the local transform goes through the setters
+// here and marks the cached world transform dirty
+class SceneNode : private sf::Transformable, public sf::Drawable, public sf::NonCopyable {
     public:
-        typedef std::unique_ptr<SceneNode> Ptr;
+        typedef std::unique_ptr<SceneNode, NodeDeleter> Ptr;
         typedef std::pair<SceneNode*, SceneNode*> Pair;
+
+        enum Lifecycle : sf::Uint8 {
+            Alive,
+            Destroyed,
+            MarkedForRemoval
+        };
     public:
         explicit SceneNode(Category::Type category = Category::None);
+        virtual ~SceneNode();
+        void setRegistry(SceneRegistry& registry);
         void attachChild(Ptr child);
         Ptr detachChild(const SceneNode& node);
         void update(sf::Time dt, CommandQueue& commands);
+        void setPosition(float x, float y);
+        void setPosition(sf::Vector2f position);
+        void setRotation(float angle);
+        void setScale(float factorX, float factorY);
+        void move(float offsetX, float offsetY);
+        void move(sf::Vector2f offset);
+        void rotate(float angle);
+        using sf::Transformable::getPosition;
+        using sf::Transformable::getRotation;
+        using sf::Transformable::getScale;
+        using sf::Transformable::getOrigin;
+        using sf::Transformable::getTransform;
+        using sf::Transformable::getInverseTransform;
+        NodeHandle getHandle() const;
         sf::Vector2f getWorldPosition() const;
-        sf::Transform getWorldTransform() const;
-        void onCommand(const Command& command, sf::Time dt);
-        virtual unsigned int getCategory() const;
-        void checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPair);
-        void checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPair);
+        const sf::Transform& getWorldTransform() const;
+        void updateWorldTransforms();
+        unsigned int getCategory() const;
         void removeWrecks();
-        virtual sf::FloatRect getBoundingRect() const;
-        virtual bool isMarkedForRemoval() const;
-        virtual bool isDestroyed() const;
+        SceneNode* getParent() const;
+        sf::FloatRect getBoundingRect() const;
+        virtual sf::Vector2f getSweep() const;
+        virtual const sf::Sprite* getCollisionSprite() const;
+        sf::FloatRect getSweptBoundingRect() const;
+        sf::FloatRect getSubtreeBounds() const;
+        bool isMarkedForRemoval() const;
+        bool isDestroyed() const;
+        std::size_t getFootprint() const;
+    protected:
+        void markBoundsDirty();
+        void setLifecycle(Lifecycle lifecycle);
+        Lifecycle getLifecycle() const;
     private:
+        virtual sf::FloatRect computeBoundingRect() const;
+        virtual bool isUnbounded() const;
+        virtual std::size_t getNodeSize() const;
         virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
         void updateChildren(sf::Time dt, CommandQueue& commands);
+        SceneNode* getFirstChild() const;
+        SceneNode* getNextSibling() const;
+        void unlinkChild(SceneNode& child, SceneNode* previous);
         virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
         virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
         void drawChildren(sf::RenderTarget& target, sf::RenderStates states) const;
         void drawBoundingRect(sf::RenderTarget& target, sf::RenderStates states) const;
+        void registerSubtree(SceneRegistry& registry);
+        void unregisterSubtree();
+        void vacateSubtree();
+        const std::vector<SceneNode*>& getOrder() const;
+        void linearize(std::vector<SceneNode*>& order);
+        void markTransformDirty();
+        void updateBounds() const;
+        bool isOutsideView(const sf::RenderTarget& target) const;
     private:
-        std::vector<Ptr> mChildren;
+        // Intrusive sibling list, children are owned and freed through their stored deleter
         SceneNode* mParent;
-        Category::Type mDefaultCategory;
+        SceneNode* mFirstChild;
+        SceneNode* mLastChild;
+        SceneNode* mNextSibling;
+        NodeDeleter mDeleter;
+        Category::Type mCategory;
+        Lifecycle mLifecycle;
+        SceneRegistry* mRegistry;
+        std::size_t mRegistryIndex;
+        NodeHandle mHandle;
+        std::size_t mOrderIndex;
+        std::size_t mOrderEnd;
+        mutable sf::Transform mWorldTransform;
+        mutable bool mTransformDirty;
+        mutable sf::FloatRect mBounds;
+        mutable sf::FloatRect mSubtreeBounds;
+        mutable bool mSubtreeUnbounded;
+        mutable bool mBoundsDirty;
+};
+
+NodeDeleter::NodeDeleter()
+: release(nullptr) {
+}
+
+NodeDeleter::NodeDeleter(void (*release)(SceneNode*))
+: release(release) {
+}
+
+template <typename T>
+NodeDeleter::NodeDeleter(const std::default_delete<T>&)
+: release(nullptr) {
+}
+
+void NodeDeleter::operator() (SceneNode* node) const {
+    if (release)
+        release(node);
+    else
+        delete node;
+}
+
+// Snapshot of a node's collision state, read concurrently by the narrow phase
+struct Collider {
+    SceneNode* node;
+    unsigned int category;
+    sf::FloatRect bounds;
+    sf::FloatRect sweptBounds;
+    sf::Vector2f sweep;
+    sf::Vector2f position;
+    const CollisionMask* mask;
 };
 
-bool collision(const SceneNode& lhs, const SceneNode& rhs) {
-    return lhs.getBoundingRect().intersects(rhs.getBoundingRect());
+Collider makeCollider(SceneNode& node, const CollisionMaskHolder& masks) {
+    const sf::Sprite* sprite = node.getCollisionSprite();
+
+    Collider collider;
+    collider.node = &node;
+    collider.category = node.getCategory();
+    collider.bounds = node.getBoundingRect();
+    collider.sweptBounds = node.getSweptBoundingRect();
+    collider.sweep = node.getSweep();
+    collider.position = node.getWorldPosition();
+    collider.mask = sprite ? masks.get(*sprite, node.getRotation()) : nullptr;
+    return collider;
+}
+
+bool collision(const Collider& lhs, const Collider& rhs) {
+    return Utility::sweptIntersects(lhs.bounds, lhs.sweep, rhs.bounds, rhs.sweep);
+}
+
+bool pixelCollision(const Collider& lhs, const Collider& rhs) {
+    if (!lhs.mask || !rhs.mask)
+        return true;
+
+    // A hit found only by sweeping has no overlapping pixels to compare
+    if (!lhs.bounds.intersects(rhs.bounds))
+        return true;
+
+    return lhs.mask->test(lhs.position, *rhs.mask, rhs.position);
 }
 
 bool distance(const SceneNode& lhs, const SceneNode& rhs) {
     return Utility::length(lhs.getWorldPosition() - rhs.getWorldPosition());
 }
 
-SceneNode::SceneNode(Category::Type category) : mChildren(), mParent(nullptr), mDefaultCategory(category) {
+SceneNode::SceneNode(Category::Type category) 
+: mParent(nullptr), mFirstChild(nullptr), mLastChild(nullptr), mNextSibling(nullptr), mDeleter(), mCategory(category), mLifecycle(Alive), mRegistry(nullptr), mRegistryIndex(0), mHandle(), mOrderIndex(0), mOrderEnd(0), 
+mWorldTransform(), mTransformDirty(true), mBounds(), mSubtreeBounds(), mSubtreeUnbounded(false), mBoundsDirty(true) {
+}
+
+SceneNode::~SceneNode() {
+    SceneNode* child = getFirstChild();
+    while (child) {
+        SceneNode* next = child->getNextSibling();
+        child->mDeleter(child);
+        child = next;
+    }
+}
+
+void SceneNode::setRegistry(SceneRegistry& registry) {
+    assert(mParent == nullptr && mRegistry == nullptr);
+    registerSubtree(registry);
 }
 
 void SceneNode::attachChild(Ptr child) {
-    child->mParent = this;
-    mChildren.push_back(std::move(child));
+    // The parent takes over ownership, the deleter goes with the node so it returns to its pool
+    SceneNode* node = child.get();
+    node->mDeleter = child.get_deleter();
+    child.release();
+
+    // Appended, siblings keep the order they were attached in
+    node->mParent = this;
+    node->mNextSibling = nullptr;
+    if (mLastChild)
+        mLastChild->mNextSibling = node;
+    else
+        mFirstChild = node;
+    mLastChild = node;
+
+    node->markTransformDirty();
+    if (mRegistry) {
+        node->registerSubtree(*mRegistry);
+        mRegistry->invalidateOrder();
+    }
 }
 
 SceneNode::Ptr SceneNode::detachChild(const SceneNode& node) {
-    auto found = std::find_if(mChildren.begin(), mChildren.end(), [&](Ptr& p){ return p.get() == &node; });
-    assert(found != mChildren.end());
+    assert(node.mParent == this);
 
-    Ptr result = std::move(*found);
-    result->mParent = nullptr;
-    mChildren.erase(found);
-    return result;    
+    SceneNode* previous = nullptr;
+    SceneNode* child = getFirstChild();
+    while (child != &node) {
+        previous = child;
+        child = child->getNextSibling();
+    }
+
+    if (mRegistry)
+        mRegistry->invalidateOrder();
+    child->unregisterSubtree();
+    unlinkChild(*child, previous);
+    child->markTransformDirty();
+    markBoundsDirty();
+    return Ptr(child, child->mDeleter);
 }
 
 void SceneNode::update(sf::Time dt, CommandQueue& commands) {
-    updateCurrent(dt, commands);
-    updateChildren(dt, commands);
+    if (!mRegistry) {
+        // Wrecks wait for compaction, they no longer take part in the scene
+        if (isMarkedForRemoval())
+            return;
+
+        updateCurrent(dt, commands);
+        updateChildren(dt, commands);
+        return;
+    }
+
+    // The subtree is a contiguous range of the depth-first order, a wreck skips to the end of its own range.
+    // Nodes attached during the scan are past the range and wait for the next tick
+    const std::vector<SceneNode*>& order = getOrder();
+    for (std::size_t i = mOrderIndex, end = mOrderEnd; i < end; ) {
+        SceneNode* node = order[i];
+        if (node->isMarkedForRemoval()) {
+            i = node->mOrderEnd;
+            continue;
+        }
+
+        node->updateCurrent(dt, commands);
+        ++i;
+    }
 }
 
-sf::Vector2f SceneNode::getWorldPosition() const {
-    return getWorldTransform() * sf::Vector2f();
+void SceneNode::setPosition(float x, float y) {
+    sf::Transformable::setPosition(x, y);
+    markTransformDirty();
 }
 
-sf::Transform SceneNode::getWorldTransform() const {
-    sf::Transform transform = sf::Transform::Identity;
+void SceneNode::setPosition(sf::Vector2f position) {
+    sf::Transformable::setPosition(position);
+    markTransformDirty();
+}
 
-    for (const SceneNode* node = this; node != nullptr; node = node->mParent)
-        transform = node->getTransform() * transform;
+void SceneNode::setRotation(float angle) {
+    sf::Transformable::setRotation(angle);
+    markTransformDirty();
+}
 
-    return transform;
+void SceneNode::setScale(float factorX, float factorY) {
+    sf::Transformable::setScale(factorX, factorY);
+    markTransformDirty();
 }
 
-void SceneNode::onCommand(const Command& command, sf::Time dt) {
-    if (command.category & getCategory())
-        command.action(*this, dt);
+void SceneNode::move(float offsetX, float offsetY) {
+    sf::Transformable::move(offsetX, offsetY);
+    markTransformDirty();
+}
 
-    for (auto& child : mChildren)
-        child->onCommand(command, dt);
+void SceneNode::move(sf::Vector2f offset) {
+    sf::Transformable::move(offset);
+    markTransformDirty();
 }
 
-unsigned int SceneNode::getCategory() const {
-    return mDefaultCategory;
+void SceneNode::rotate(float angle) {
+    sf::Transformable::rotate(angle);
+    markTransformDirty();
 }
 
-void SceneNode::checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPair) {
-    checkNodeCollision(sceneGraph, collisionPair);
-    
-    for (auto& child : sceneGraph.mChildren) {
-        checkSceneCollision(*child, collisionPair);
-    }
+NodeHandle SceneNode::getHandle() const {
+    return mHandle;
+}
+
+sf::Vector2f SceneNode::getWorldPosition() const {
+    return getWorldTransform() * sf::Vector2f();
 }
 
-void SceneNode::checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPair) {
-    if (this != &node && collision(*this, node) && !isDestroyed() && !node.isDestroyed()) {
-        collisionPair.insert(std::minmax(this, &node));
+const sf::Transform& SceneNode::getWorldTransform() const {
+    // Recomputed lazily when read between updates, a clean parent stops the walk
+    if (mTransformDirty) {
+        SceneNode* parent = getParent();
+        mWorldTransform = parent ? parent->getWorldTransform() * getTransform() : getTransform();
+        mTransformDirty = false;
     }
-		
-    for (auto& child : mChildren) {
-        child->checkNodeCollision(node, collisionPair);
+
+    return mWorldTransform;
+}
+
+void SceneNode::updateWorldTransforms() {
+    if (!mRegistry) {
+        getWorldTransform();
+        for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
+            child->updateWorldTransforms();
+        return;
     }
+
+    // Parents come before their children, so each lazy refresh finds a clean parent
+    const std::vector<SceneNode*>& order = getOrder();
+    for (std::size_t i = mOrderIndex; i < mOrderEnd; ++i)
+        order[i]->getWorldTransform();
+}
+
+unsigned int SceneNode::getCategory() const {
+    return mCategory;
 }
 
 void SceneNode::removeWrecks() {
-	auto wreckfieldBegin = std::remove_if(mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::isMarkedForRemoval));
-	mChildren.erase(wreckfieldBegin, mChildren.end());
-	std::for_each(mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::removeWrecks));
+	// Direct children only, the world visits the parents of its tombstones
+	bool removed = false;
+	SceneNode* previous = nullptr;
+	SceneNode* child = getFirstChild();
+
+	while (child) {
+		SceneNode* next = child->getNextSibling();
+		if (child->isMarkedForRemoval()) {
+			child->unregisterSubtree();
+			unlinkChild(*child, previous);
+			child->mDeleter(child);
+			removed = true;
+		} else {
+			previous = child;
+		}
+		child = next;
+	}
+
+	if (removed) {
+		markBoundsDirty();
+		if (mRegistry)
+			mRegistry->invalidateOrder();
+	}
+}
+
+SceneNode* SceneNode::getParent() const {
+    return mParent;
 }
 
 sf::FloatRect SceneNode::getBoundingRect() const {
-    return sf::FloatRect();
+    if (mBoundsDirty)
+        updateBounds();
+
+    return mBounds;
+}
+
+sf::Vector2f SceneNode::getSweep() const {
+    return sf::Vector2f();
+}
+
+const sf::Sprite* SceneNode::getCollisionSprite() const {
+    return nullptr;
+}
+
+sf::FloatRect SceneNode::getSweptBoundingRect() const {
+    sf::FloatRect bounds = getBoundingRect();
+    sf::Vector2f sweep = getSweep();
+
+    sf::FloatRect start(bounds.left - sweep.x, bounds.top - sweep.y, bounds.width, bounds.height);
+    return Utility::unite(start, bounds);
+}
+
+sf::FloatRect SceneNode::getSubtreeBounds() const {
+    if (mBoundsDirty)
+        updateBounds();
+
+    return mSubtreeBounds;
 }
 
 bool SceneNode::isMarkedForRemoval() const {
-    return isDestroyed();
+    return mLifecycle == MarkedForRemoval;
 }
 
 bool SceneNode::isDestroyed() const {
+    return mLifecycle != Alive;
+}
+
+std::size_t SceneNode::getFootprint() const {
+    // The node and its subtree, storage the nodes own on the heap is not counted
+    std::size_t bytes = getNodeSize();
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
+        bytes += child->getFootprint();
+    return bytes;
+}
+
+void SceneNode::markBoundsDirty() {
+    // A dirty node always has dirty ancestors, so the walk stops at the first one already marked
+    for (SceneNode* node = this; node != nullptr && !node->mBoundsDirty; node = node->getParent())
+        node->mBoundsDirty = true;
+}
+
+void SceneNode::setLifecycle(Lifecycle lifecycle) {
+    Lifecycle previous = mLifecycle;
+    mLifecycle = lifecycle;
+
+    if (!mRegistry || mCategory == Category::None)
+        return;
+
+    if (previous == Alive && lifecycle != Alive)
+        mRegistry->markDestroyed(*this, mCategory);
+    if (previous != MarkedForRemoval && lifecycle == MarkedForRemoval) {
+        mRegistry->markForRemoval(*this, mCategory, mHandle);
+        vacateSubtree();
+    }
+}
+
+SceneNode::Lifecycle SceneNode::getLifecycle() const {
+    return mLifecycle;
+}
+
+sf::FloatRect SceneNode::computeBoundingRect() const {
+    return sf::FloatRect();
+}
+
+bool SceneNode::isUnbounded() const {
+    // Nodes that draw outside their bounding rect must never be culled
     return false;
 }
 
+std::size_t SceneNode::getNodeSize() const {
+    return sizeof(SceneNode);
+}
+
 void SceneNode::updateCurrent(sf::Time dt, CommandQueue& commands) {
     // Do nothing by default
 }
 
 void SceneNode::updateChildren(sf::Time dt, CommandQueue& commands) {
-    for (auto& child : mChildren)
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
         child->update(dt, commands);
 }
 
+SceneNode* SceneNode::getFirstChild() const {
+    return mFirstChild;
+}
+
+SceneNode* SceneNode::getNextSibling() const {
+    return mNextSibling;
+}
+
+void SceneNode::unlinkChild(SceneNode& child, SceneNode* previous) {
+    // previous is the sibling right before child, null when child comes first
+    if (previous)
+        previous->mNextSibling = child.mNextSibling;
+    else
+        mFirstChild = child.mNextSibling;
+
+    if (mLastChild == &child)
+        mLastChild = previous;
+
+    child.mParent = nullptr;
+    child.mNextSibling = nullptr;
+}
+
 void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-    states.transform *= sf::Transformable::getTransform();
-    drawCurrent(target, states);
-    drawChildren(target, states);
-    //drawBoundingRect(target, states);
+    if (!mRegistry) {
+        if (isMarkedForRemoval() || isOutsideView(target))
+            return;
+
+        states.transform *= sf::Transformable::getTransform();
+        drawCurrent(target, states);
+        drawChildren(target, states);
+        //drawBoundingRect(target, states);
+        return;
+    }
+
+    // States carry the parent's transform, which the cached world transforms already contain
+    sf::Transform base = states.transform;
+    if (SceneNode* parent = getParent())
+        base *= parent->getWorldTransform().getInverse();
+
+    const std::vector<SceneNode*>& order = getOrder();
+    for (std::size_t i = mOrderIndex, end = mOrderEnd; i < end; ) {
+        const SceneNode* node = order[i];
+        if (node->isMarkedForRemoval() || node->isOutsideView(target)) {
+            i = node->mOrderEnd;
+            continue;
+        }
+
+        states.transform = base * node->getWorldTransform();
+        node->drawCurrent(target, states);
+        ++i;
+    }
 }
 
 void SceneNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const {
@@ -158,7 +527,7 @@ void SceneNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) c
 }
 
 void SceneNode::drawChildren(sf::RenderTarget& target, sf::RenderStates states) const {
-    for (auto& child : mChildren)
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
         child->draw(target, states);
 }
 
@@ -172,4 +541,121 @@ void SceneNode::drawBoundingRect(sf::RenderTarget& target, sf::RenderStates stat
     shape.setOutlineThickness(1.f);
 
     target.draw(shape);
-}
\ No newline at end of file
+}
+
+void SceneNode::registerSubtree(SceneRegistry& registry) {
+    mRegistry = &registry;
+    if (getCategory() != Category::None) {
+        // The handle is valid before NodeSpawned goes out
+        mHandle = registry.acquireHandle(*this);
+        mRegistryIndex = registry.insert(*this, getCategory());
+    }
+
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
+        child->registerSubtree(registry);
+}
+
+void SceneNode::unregisterSubtree() {
+    if (!mRegistry)
+        return;
+
+    if (getCategory() != Category::None) {
+        SceneNode* moved = mRegistry->erase(getCategory(), mRegistryIndex);
+        if (moved)
+            moved->mRegistryIndex = mRegistryIndex;
+
+        mRegistry->releaseHandle(mHandle);
+        mHandle = NodeHandle();
+    }
+    mRegistry = nullptr;
+
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
+        child->unregisterSubtree();
+}
+
+void SceneNode::vacateSubtree() {
+    // Wrecks leave the category scans right away, their slots are erased when compaction frees them
+    if (getCategory() != Category::None)
+        mRegistry->vacate(getCategory(), mRegistryIndex);
+
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
+        child->vacateSubtree();
+}
+
+const std::vector<SceneNode*>& SceneNode::getOrder() const {
+    // Rebuilt from the root after attach, detach or compaction, at most once per structural change
+    if (mRegistry->isOrderDirty()) {
+        SceneNode* root = const_cast<SceneNode*>(this);
+        while (SceneNode* parent = root->getParent())
+            root = parent;
+
+        root->linearize(mRegistry->resetOrder());
+    }
+
+    return mRegistry->getOrder();
+}
+
+void SceneNode::linearize(std::vector<SceneNode*>& order) {
+    // Depth-first over the links without a stack, a range closes when the walk climbs out of its node
+    SceneNode* node = this;
+    for (;;) {
+        node->mOrderIndex = order.size();
+        order.push_back(node);
+
+        if (SceneNode* child = node->getFirstChild()) {
+            node = child;
+            continue;
+        }
+
+        for (;;) {
+            node->mOrderEnd = order.size();
+            if (node == this)
+                return;
+
+            if (SceneNode* sibling = node->getNextSibling()) {
+                node = sibling;
+                break;
+            }
+
+            node = node->getParent();
+        }
+    }
+}
+
+void SceneNode::markTransformDirty() {
+    // Moving a node moves the world transform and bounds of its whole subtree
+    mTransformDirty = true;
+    mBoundsDirty = true;
+
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling())
+        child->markTransformDirty();
+
+    if (SceneNode* parent = getParent())
+        parent->markBoundsDirty();
+}
+
+void SceneNode::updateBounds() const {
+    mBounds = computeBoundingRect();
+    mSubtreeBounds = mBounds;
+    mSubtreeUnbounded = isUnbounded();
+
+    for (SceneNode* child = getFirstChild(); child; child = child->getNextSibling()) {
+        mSubtreeBounds = Utility::unite(mSubtreeBounds, child->getSubtreeBounds());
+        mSubtreeUnbounded = mSubtreeUnbounded || child->mSubtreeUnbounded;
+    }
+
+    mBoundsDirty = false;
+}
+
+bool SceneNode::isOutsideView(const sf::RenderTarget& target) const {
+    // Explosions and text displays reach past the collision bounds
+    const float margin = 128.f;
+
+    sf::FloatRect bounds = getSubtreeBounds();
+    if (mSubtreeUnbounded || Utility::isEmpty(bounds))
+        return false;
+
+    const sf::View& view = target.getView();
+    sf::FloatRect viewBounds(view.getCenter() - view.getSize() / 2.f - sf::Vector2f(margin, margin), view.getSize() + sf::Vector2f(2.f * margin, 2.f * margin));
+    return !viewBounds.intersects(bounds);
+}
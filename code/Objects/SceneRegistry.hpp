@@ -0,0 +1,204 @@
+#pragma once
+
+#include "Game/Category.hpp"
+#include "Game/EventBus.hpp"
+
+#include <SFML/System.hpp>
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+
+class SceneNode;
+
+// Slot index plus generation, stays safe to resolve after the node is gone
+struct NodeHandle {
+    NodeHandle() : index(0), generation(0) {}
+    NodeHandle(std::uint32_t index, std::uint32_t generation) : index(index), generation(generation) {}
+
+    std::uint32_t index;
+    std::uint32_t generation;
+};
+
+bool operator==(NodeHandle lhs, NodeHandle rhs) {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+bool operator!=(NodeHandle lhs, NodeHandle rhs) {
+    return !(lhs == rhs);
+}
+
+class SceneRegistry : private sf::NonCopyable {
+    public:
+        explicit SceneRegistry(EventBus& events);
+        std::size_t insert(SceneNode& node, unsigned int category);
+        SceneNode* erase(unsigned int category, std::size_t index);
+        void vacate(unsigned int category, std::size_t index);
+        void markDestroyed(SceneNode& node, unsigned int category);
+        void markForRemoval(SceneNode& node, unsigned int category, NodeHandle handle);
+        NodeHandle acquireHandle(SceneNode& node);
+        void releaseHandle(NodeHandle handle);
+        SceneNode* resolve(NodeHandle handle) const;
+
+        template <typename T>
+        T* resolve(NodeHandle handle) const;
+
+        template <typename Function>
+        std::size_t forEach(unsigned int categories, Function fn) const;
+
+        std::vector<NodeHandle>& getTombstones();
+        void invalidateOrder();
+        bool isOrderDirty() const;
+        std::vector<SceneNode*>& resetOrder();
+        const std::vector<SceneNode*>& getOrder() const;
+    private:
+        struct HandleSlot {
+            SceneNode* node;
+            std::uint32_t generation;
+        };
+
+        // A vacant entry belongs to a wreck, it keeps its slot until compaction erases it
+        struct BucketEntry {
+            SceneNode* node;
+            bool vacant;
+        };
+    private:
+        static std::size_t toBucket(unsigned int category);
+    private:
+        std::array<std::vector<BucketEntry>, std::numeric_limits<unsigned int>::digits> mBuckets;
+        std::vector<HandleSlot> mHandleSlots;
+        std::vector<std::uint32_t> mFreeHandleSlots;
+        std::vector<NodeHandle> mTombstones;
+        std::vector<SceneNode*> mOrder;
+        bool mOrderDirty;
+        EventBus& mEvents;
+};
+
+SceneRegistry::SceneRegistry(EventBus& events)
+: mBuckets(), mHandleSlots(), mFreeHandleSlots(), mTombstones(), mOrder(), mOrderDirty(true), mEvents(events) {
+}
+
+std::size_t SceneRegistry::insert(SceneNode& node, unsigned int category) {
+    std::vector<BucketEntry>& bucket = mBuckets[toBucket(category)];
+    bucket.push_back(BucketEntry{&node, false});
+    mEvents.publish(NodeSpawned{&node, category});
+    return bucket.size() - 1;
+}
+
+SceneNode* SceneRegistry::erase(unsigned int category, std::size_t index) {
+    // Swap with the last node, returns the node that now lives at index
+    std::vector<BucketEntry>& bucket = mBuckets[toBucket(category)];
+    assert(index < bucket.size());
+
+    bucket[index] = bucket.back();
+    bucket.pop_back();
+    return (index < bucket.size()) ? bucket[index].node : nullptr;
+}
+
+void SceneRegistry::vacate(unsigned int category, std::size_t index) {
+    // Only flagged, so a scan in progress over the bucket keeps its indices
+    std::vector<BucketEntry>& bucket = mBuckets[toBucket(category)];
+    assert(index < bucket.size());
+
+    bucket[index].vacant = true;
+}
+
+void SceneRegistry::markDestroyed(SceneNode& node, unsigned int category) {
+    mEvents.publish(NodeDestroyed{&node, category});
+}
+
+void SceneRegistry::markForRemoval(SceneNode& node, unsigned int category, NodeHandle handle) {
+    mTombstones.push_back(handle);
+    mEvents.publish(NodeRemoved{&node, category});
+}
+
+NodeHandle SceneRegistry::acquireHandle(SceneNode& node) {
+    if (mFreeHandleSlots.empty())
+        mHandleSlots.push_back(HandleSlot{nullptr, 1});
+
+    std::uint32_t index = static_cast<std::uint32_t>(mHandleSlots.size() - 1);
+    if (!mFreeHandleSlots.empty()) {
+        index = mFreeHandleSlots.back();
+        mFreeHandleSlots.pop_back();
+    }
+
+    mHandleSlots[index].node = &node;
+    return NodeHandle(index, mHandleSlots[index].generation);
+}
+
+void SceneRegistry::releaseHandle(NodeHandle handle) {
+    assert(resolve(handle) != nullptr);
+
+    // Bumping the generation invalidates every copy of the handle, the slot is reused right away
+    HandleSlot& slot = mHandleSlots[handle.index];
+    slot.node = nullptr;
+    ++slot.generation;
+    mFreeHandleSlots.push_back(handle.index);
+}
+
+SceneNode* SceneRegistry::resolve(NodeHandle handle) const {
+    if (handle.index >= mHandleSlots.size() || mHandleSlots[handle.index].generation != handle.generation)
+        return nullptr;
+
+    return mHandleSlots[handle.index].node;
+}
+
+template <typename T>
+T* SceneRegistry::resolve(NodeHandle handle) const {
+    return static_cast<T*>(resolve(handle));
+}
+
+template <typename Function>
+std::size_t SceneRegistry::forEach(unsigned int categories, Function fn) const {
+    // Returns the entries walked, vacant ones included
+    std::size_t visited = 0;
+
+    for (std::size_t bucket = 0; categories != 0; ++bucket, categories >>= 1) {
+        if (categories & 1u) {
+            // Nodes attached by fn land past the snapshot and are not visited
+            const std::vector<BucketEntry>& entries = mBuckets[bucket];
+            std::size_t size = entries.size();
+            for (std::size_t i = 0; i < size; ++i)
+                if (!entries[i].vacant)
+                    fn(*entries[i].node);
+            visited += size;
+        }
+    }
+
+    return visited;
+}
+
+std::vector<NodeHandle>& SceneRegistry::getTombstones() {
+    return mTombstones;
+}
+
+void SceneRegistry::invalidateOrder() {
+    mOrderDirty = true;
+}
+
+bool SceneRegistry::isOrderDirty() const {
+    return mOrderDirty;
+}
+
+std::vector<SceneNode*>& SceneRegistry::resetOrder() {
+    // Capacity is kept, rebuilding after a spawn does not allocate
+    mOrder.clear();
+    mOrderDirty = false;
+    return mOrder;
+}
+
+const std::vector<SceneNode*>& SceneRegistry::getOrder() const {
+    return mOrder;
+}
+
+std::size_t SceneRegistry::toBucket(unsigned int category) {
+    // Nodes belong to exactly one category
+    assert(category != 0 && (category & (category - 1)) == 0);
+
+    std::size_t bucket = 0;
+    while ((category >>= 1) != 0)
+        ++bucket;
+    return bucket;
+}
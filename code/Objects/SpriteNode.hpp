@@ -7,6 +7,8 @@ class SpriteNode : public SceneNode {
         explicit SpriteNode(const sf::Texture& texture);
         SpriteNode(const sf::Texture& texture, const sf::IntRect& textureRect);
     private:
+        virtual std::size_t getNodeSize() const;
+        virtual sf::FloatRect computeBoundingRect() const;
         virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
     private:
         sf::Sprite mSprite;
@@ -20,6 +22,14 @@ SpriteNode::SpriteNode(const sf::Texture& texture, const sf::IntRect& textureRec
 : mSprite(texture, textureRect) {
 }
 
+std::size_t SpriteNode::getNodeSize() const {
+    return sizeof(SpriteNode);
+}
+
+sf::FloatRect SpriteNode::computeBoundingRect() const {
+    return getWorldTransform().transformRect(mSprite.getGlobalBounds());
+}
+
 void SpriteNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const {
     target.draw(mSprite, states);    
 }
@@ -9,6 +9,8 @@ class TextNode : public SceneNode {
         explicit TextNode(const FontHolder& fonts, const std::string& text);
         void setString(const std::string& text);
     private:
+        virtual std::size_t getNodeSize() const;
+        virtual sf::FloatRect computeBoundingRect() const;
         virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
     private:
         sf::Text mText;
@@ -23,6 +25,15 @@ TextNode::TextNode(const FontHolder& fonts, const std::string& text) {
 void TextNode::setString(const std::string& text) {
     mText.setString(text);
     Utility::centerOrigin(mText);
+    markBoundsDirty();
+}
+
+std::size_t TextNode::getNodeSize() const {
+    return sizeof(TextNode);
+}
+
+sf::FloatRect TextNode::computeBoundingRect() const {
+    return getWorldTransform().transformRect(mText.getGlobalBounds());
 }
 
 void TextNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const {
@@ -4,14 +4,28 @@
 #include "Objects/SpriteNode.hpp"
 #include "Objects/Aircraft.hpp"
 #include "Objects/ParticleNode.hpp"
+#include "Objects/BulletNode.hpp"
+#include "Objects/NodePool.hpp"
+#include "Objects/ContactManager.hpp"
 #include "Game/CommandQueue.hpp"
+#include "Game/PlayerInput.hpp"
+#include "Game/CommandProfiler.hpp"
+#include "Game/EventBus.hpp"
+#include "Effects/SoundEventBuffer.hpp"
+#include "Game/CollisionMatrix.hpp"
+#include "Utils/SpatialGrid.hpp"
+#include "Utils/RectBatch.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "Utils/MpscQueue.hpp"
+#include "Utils/FrameArena.hpp"
+#include "Utils/AllocationCounter.hpp"
 #include "Effects/BloomEffect.hpp"
 
 #include <array>
 #include <cmath>
-#include <set>
 #include <algorithm>
 #include <limits>
+#include <ostream>
 
 class World : private sf::NonCopyable {
     public:
@@ -19,20 +33,37 @@ class World : private sf::NonCopyable {
         void update(sf::Time dt);
         void draw();
         CommandQueue& getCommandQueue();
-        bool hasAlivePlayer() const;
-        bool hasPlayerReachedEnd() const;
+        void setPlayerInput(const PlayerInput& input);
+        MpscQueue<Command>& getConcurrentCommandQueue();
+        const CommandProfiler& getCommandProfiler() const;
+        EventBus& getEventBus();
+        void reportMemory(std::ostream& stream) const;
+        void onEvent(const NodeSpawned& event);
+        void onEvent(const NodeDestroyed& event);
+        void onEvent(const NodeRemoved& event);
+    private:
+        typedef std::pair<const Collider*, const Collider*> ColliderPair;
     private:
         void loadTextures();
+        void loadCollisionMasks();
         void adaptPlayerPosition();
+        void applyPlayerInput();
         void adaptPlayerVelocity();
         void handleCollisions();
+        void findCollisionPairs();
+        void testCollisionPairs(const FrameVector<ColliderPair>& candidates);
+        void handleBulletHits();
         void updateSounds();
         void buildScene();
         void addEnemies();
         void addEnemy(Aircraft::Type type, float relX, float relY);
         void spawnEnemies();
+        void removeWrecks();
+        void dispatchCommand(const Command& command, sf::Time dt);
         void destroyEntitiesOutsideView();
         void guideMissiles();
+        Aircraft* getPlayerAircraft() const;
+        void checkPlayerReachedEnd();
         sf::FloatRect getViewBounds() const;
         sf::FloatRect getBattlefieldBounds() const;
 
@@ -44,6 +75,10 @@ class World : private sf::NonCopyable {
             LayerCount
         };
 
+        // Wrecks are freed in batches of this many, or after this many ticks, whichever comes first
+        static const std::size_t WreckBatchSize = 32;
+        static const unsigned int CompactionInterval = 30;
+
         struct SpawnPoint {
             SpawnPoint(Aircraft::Type type, float x, float y)
             : type(type), x(x), y(y) {
@@ -59,16 +94,33 @@ class World : private sf::NonCopyable {
         TextureHolder mTextures;
         FontHolder& mFonts;
         SoundPlayer& mSounds;
+        SoundEventBuffer mSoundEvents;
+        EventBus mEventBus;
+        SceneRegistry mSceneRegistry;
         SceneNode mSceneGraph;
         std::array<SceneNode*, LayerCount> mSceneLayers;
         CommandQueue mCommandQueue;
+        PlayerInput mPlayerInput;
+        MpscQueue<Command> mConcurrentCommands;
+        CommandProfiler mCommandProfiler;
+        FrameArena mFrameArena;
+        std::size_t mTickAllocations;
+        SpatialGrid<Collider> mCollisionGrid;
+        std::vector<std::vector<SceneNode::Pair>> mNarrowPhaseHits;
+        CollisionMatrix mCollisionMatrix;
+        CollisionMaskHolder mCollisionMasks;
+        ContactManager mContacts;
+        unsigned int mTicksSinceCompaction;
         sf::FloatRect mWorldBounds;
         sf::Vector2f mSpawnPosition;
         float mScrollSpeed;
-        Aircraft* mPlayerAircraft;
+        NodeHandle mPlayerAircraft;
+        bool mPlayerReachedEnd;
         std::vector<SpawnPoint> mEnemySpawnPoints;
-        std::vector<Aircraft*> mActiveEnemies;
+        std::vector<NodeHandle> mActiveEnemies;
+        RectBatch mViewCandidateBounds;
         BloomEffect mBloomEffect;
+        ThreadPool mThreadPool;
 };
 
 World::World(sf::RenderTarget& outputTarget, FontHolder& fonts, SoundPlayer& sounds) 
@@ -78,38 +130,86 @@ mWorldView(outputTarget.getDefaultView()),
 mTextures(), 
 mFonts(fonts),
 mSounds(sounds),
+mSoundEvents(),
+mEventBus(),
+mSceneRegistry(mEventBus),
 mSceneGraph(), 
 mSceneLayers(),
+mConcurrentCommands(1024),
+mFrameArena(256 * 1024),
+mTickAllocations(0),
+mCollisionGrid(mWorldView.getSize() / 8.f),
+mNarrowPhaseHits(),
+mCollisionMatrix(),
+mCollisionMasks(),
+mContacts(),
+mTicksSinceCompaction(0),
 mWorldBounds(0.f, 0.f, mWorldView.getSize().x, 5000.f), 
 mSpawnPosition(mWorldView.getSize().x / 2.f, mWorldBounds.height - mWorldView.getSize().y / 2.f),
 mScrollSpeed(-50.f), 
-mPlayerAircraft(nullptr), 
+mPlayerAircraft(), 
+mPlayerReachedEnd(false),
 mEnemySpawnPoints(), 
 mActiveEnemies(),
-mBloomEffect() {
+mViewCandidateBounds(),
+mBloomEffect(),
+mThreadPool(std::max(1u, std::thread::hardware_concurrency()) - 1) {
     mSceneTexture.create(mTarget.getSize().x, mTarget.getSize().y);
+    mEventBus.subscribe<NodeSpawned>(*this);
+    mEventBus.subscribe<NodeDestroyed>(*this);
+    mEventBus.subscribe<NodeRemoved>(*this);
+    mSceneGraph.setRegistry(mSceneRegistry);
+
+    mCollisionMatrix.add(Category::PlayerAircraft, Category::EnemyAircraft);
+    mCollisionMatrix.add(Category::PlayerAircraft, Category::Pickup);
+    mCollisionMatrix.add(Category::EnemyAircraft, Category::AlliedProjectile);
+    mCollisionMatrix.add(Category::PlayerAircraft, Category::EnemyProjectile);
+    mNarrowPhaseHits.resize(mThreadPool.getThreadCount());
+
     loadTextures();
+    loadCollisionMasks();
     buildScene();
     mWorldView.setCenter(mSpawnPosition);
 }
 
 void World::update(sf::Time dt) {
+    // Nothing allocated from the arena survives the tick
+    mFrameArena.reset();
+
+    // Only the simulation thread is counted, the narrow phase workers are left out
+    AllocationCounter::Scope counting;
+    std::size_t allocations = AllocationCounter::getCount();
+
     mWorldView.move(0.f, mScrollSpeed * dt.asSeconds());
-    mPlayerAircraft->setVelocity(0.f, 0.f);
 
     destroyEntitiesOutsideView();
     guideMissiles();
 
+    // Commands from other threads join the tick at the same point as everything else
+    Command command;
+    while (mConcurrentCommands.tryPop(command))
+        mCommandQueue.push(std::move(command));
+
+    // Commands pushed from here on, including by scene updates, are handled next tick
+    mCommandQueue.swapBuffers();
+    mCommandProfiler.beginTick();
     while (!mCommandQueue.isEmpty())
-        mSceneGraph.onCommand(mCommandQueue.pop(), dt);
+        dispatchCommand(mCommandQueue.pop(), dt);
+    mCommandProfiler.endTick();
+    applyPlayerInput();
     adaptPlayerVelocity();
     handleCollisions();
-    mSceneGraph.removeWrecks();
+    mContacts.removeWrecks();
+    removeWrecks();
     spawnEnemies();
     mSceneGraph.update(dt, mCommandQueue);
     adaptPlayerPosition();
+    mSceneGraph.updateWorldTransforms();
+    checkPlayerReachedEnd();
 
     updateSounds();
+
+    mTickAllocations = AllocationCounter::getCount() - allocations;
 }
 
 void World::draw() {
@@ -130,12 +230,102 @@ CommandQueue& World::getCommandQueue() {
     return mCommandQueue;
 }
 
-bool World::hasAlivePlayer() const {
-    return !mPlayerAircraft->isMarkedForRemoval();
+const CommandProfiler& World::getCommandProfiler() const {
+    return mCommandProfiler;
+}
+
+void World::setPlayerInput(const PlayerInput& input) {
+    mPlayerInput = input;
+}
+
+MpscQueue<Command>& World::getConcurrentCommandQueue() {
+    return mConcurrentCommands;
 }
 
-bool World::hasPlayerReachedEnd() const {
-    return !mWorldBounds.contains(mPlayerAircraft->getPosition());
+EventBus& World::getEventBus() {
+    return mEventBus;
+}
+
+void World::reportMemory(std::ostream& stream) const {
+    stream << "Frame arena: " << mFrameArena.getUsed() << " bytes used, " << mFrameArena.getPeak() << " peak, " << mFrameArena.getCapacity() << " capacity\n";
+    if (AllocationCounter::isEnabled())
+        stream << "Heap allocations last tick: " << mTickAllocations << "\n";
+    else
+        stream << "Heap allocations last tick: not counted, configure with DESERT_RAID_COUNT_ALLOCS=ON\n";
+    NodePool<Aircraft>::instance().report(stream, "Aircraft");
+    NodePool<Projectile>::instance().report(stream, "Projectile");
+    NodePool<Pickup>::instance().report(stream, "Pickup");
+    NodePool<EmitterNode>::instance().report(stream, "EmitterNode");
+    NodePool<TextNode>::instance().report(stream, "TextNode");
+
+    // Averaged over the live nodes with everything attached to them, 0 when none is alive
+    auto averageFootprint = [&] (unsigned int categories) {
+        std::size_t bytes = 0;
+        std::size_t count = 0;
+        mSceneRegistry.forEach(categories, [&] (SceneNode& node) {
+            bytes += node.getFootprint();
+            ++count;
+        });
+        return count ? bytes / count : 0;
+    };
+
+    stream << "Bytes per entity: aircraft " << averageFootprint(Category::Aircraft)
+        << ", missile " << averageFootprint(Category::Projectile) << ", pickup " << averageFootprint(Category::Pickup)
+        << ", bullet " << BulletNode::getBytesPerBullet() << "\n";
+
+    // Only the player carries a missile display, so each type gets its own average
+    const char* typeNames[Aircraft::TypeCount] = {"Eagle", "Raptor", "Avenger"};
+    std::size_t typeBytes[Aircraft::TypeCount] = {};
+    std::size_t typeCounts[Aircraft::TypeCount] = {};
+    mSceneRegistry.forEach(Category::Aircraft, [&] (SceneNode& node) {
+        Aircraft::Type type = static_cast<Aircraft&>(node).getAircraftType();
+        typeBytes[type] += node.getFootprint();
+        ++typeCounts[type];
+    });
+
+    stream << "Bytes per aircraft:";
+    for (int type = 0; type < Aircraft::TypeCount; ++type)
+        stream << (type == 0 ? " " : ", ") << typeNames[type] << " " << (typeCounts[type] ? typeBytes[type] / typeCounts[type] : 0);
+    stream << "\n";
+}
+
+void World::onEvent(const NodeSpawned& event) {
+    if (event.category == Category::EnemyAircraft)
+        mActiveEnemies.push_back(event.node->getHandle());
+
+    // Emitters and particle systems find each other once, whichever spawns last
+    if (event.category == Category::ParticleEmitter) {
+        EmitterNode& emitter = static_cast<EmitterNode&>(*event.node);
+        mSceneRegistry.forEach(Category::ParticleSystem, [&] (SceneNode& node) {
+            ParticleNode& system = static_cast<ParticleNode&>(node);
+            if (system.getParticleType() == emitter.getParticleType())
+                emitter.setParticleSystem(system);
+        });
+    }
+    else if (event.category == Category::ParticleSystem) {
+        ParticleNode& system = static_cast<ParticleNode&>(*event.node);
+        mSceneRegistry.forEach(Category::ParticleEmitter, [&] (SceneNode& node) {
+            EmitterNode& emitter = static_cast<EmitterNode&>(node);
+            if (!emitter.hasParticleSystem() && system.getParticleType() == emitter.getParticleType())
+                emitter.setParticleSystem(system);
+        });
+    }
+}
+
+void World::onEvent(const NodeDestroyed& event) {
+    if (event.category == Category::EnemyAircraft) {
+        auto found = std::find(mActiveEnemies.begin(), mActiveEnemies.end(), event.node->getHandle());
+        if (found != mActiveEnemies.end()) {
+            *found = mActiveEnemies.back();
+            mActiveEnemies.pop_back();
+        }
+    }
+}
+
+void World::onEvent(const NodeRemoved& event) {
+    // The player is gone once the explosion has played
+    if (event.node->getHandle() == mPlayerAircraft)
+        mEventBus.publish(PlayerDied());
 }
 
 void World::loadTextures() {
@@ -146,47 +336,88 @@ void World::loadTextures() {
     mTextures.load(Textures::FinishLine, "../assets/Textures/FinishLine.png");
 }
 
+void World::loadCollisionMasks() {
+    std::vector<sf::IntRect> rects;
+
+    for (const AircraftData& data : AircraftTable) {
+        rects.push_back(data.textureRect);
+
+        if (data.hasRollAnimation) {
+            sf::IntRect rect = data.textureRect;
+            rects.emplace_back(rect.left + rect.width, rect.top, rect.width, rect.height);
+            rects.emplace_back(rect.left + 2 * rect.width, rect.top, rect.width, rect.height);
+        }
+    }
+
+    for (const ProjectileData& data : ProjectileTable)
+        rects.push_back(data.textureRect);
+
+    for (const PickupData& data : PickupTable)
+        rects.push_back(data.textureRect);
+
+    mCollisionMasks.load(mTextures.get(Textures::Entities), rects);
+}
+
 void World::adaptPlayerPosition() {
+    Aircraft* player = getPlayerAircraft();
+    if (!player)
+        return;
+
     sf::FloatRect viewBounds = getViewBounds();
     const float borderDistance = 40.f;
-    sf::Vector2f position = mPlayerAircraft->getPosition();
+    sf::Vector2f position = player->getPosition();
     position.x = std::max(position.x, viewBounds.left + borderDistance);
     position.x = std::min(position.x, viewBounds.left + viewBounds.width - borderDistance);
     position.y = std::max(position.y, viewBounds.top + borderDistance);
     position.y = std::min(position.y, viewBounds.top + viewBounds.height - borderDistance);
-    mPlayerAircraft->setPosition(position);
+    player->setPosition(position);
+}
+
+void World::applyPlayerInput() {
+    // Applied once, a tick without new input does nothing
+    PlayerInput input = mPlayerInput;
+    mPlayerInput = PlayerInput();
+
+    Aircraft* player = getPlayerAircraft();
+    if (!player)
+        return;
+
+    player->setVelocity(0.f, 0.f);
+    player->accelerate(input.getAxis() * player->getMaxSpeed());
+
+    if (input.isActive(PlayerInput::Fire))
+        player->fire();
+    if (input.isActive(PlayerInput::LaunchMissile))
+        player->launchMissile();
 }
 
 void World::adaptPlayerVelocity() {
-    sf::Vector2f velocity = mPlayerAircraft->getVelocity();
+    Aircraft* player = getPlayerAircraft();
+    if (!player)
+        return;
+
+    sf::Vector2f velocity = player->getVelocity();
 
 	if (velocity.x != 0.f && velocity.y != 0.f)
-		mPlayerAircraft->setVelocity(velocity / std::sqrt(2.f));
+		player->setVelocity(velocity / std::sqrt(2.f));
 
-	mPlayerAircraft->accelerate(0.f, mScrollSpeed);
+	player->accelerate(0.f, mScrollSpeed);
 }
 
-bool matchesCategories(SceneNode::Pair& colliders, Category::Type type1, Category::Type type2) {
-    auto category1 = colliders.first->getCategory();
-    auto category2 = colliders.second->getCategory();
-
-    if ((type1 & category1) && (type2 & category2)) {
-        return true;
-    }
-    else if ((type1 & category2) && (type2 & category1)) {
-        std::swap(colliders.first, colliders.second);
-        return true;
-    }
-    else {
-        return false;
-    }
+bool matchesCategories(const SceneNode::Pair& colliders, Category::Type type1, Category::Type type2) {
+    // Pairs already come ordered by the collision matrix
+    return (type1 & colliders.first->getCategory()) && (type2 & colliders.second->getCategory());
 }
 
 void World::handleCollisions() {
-    std::set<SceneNode::Pair> collisionPairs;
-    mSceneGraph.checkSceneCollision(mSceneGraph, collisionPairs);
+    findCollisionPairs();
+
+    for (const ContactManager::Contact& contact : mContacts.getContacts()) {
+        // Every response destroys one side, so a contact only needs handling when it begins
+        if (contact.state != ContactManager::Begin)
+            continue;
 
-    for (auto pair : collisionPairs) {
+        const SceneNode::Pair& pair = contact.pair;
         if (matchesCategories(pair, Category::PlayerAircraft, Category::EnemyAircraft)) {
             auto& player = static_cast<Aircraft&>(*pair.first);
             auto& enemy = static_cast<Aircraft&>(*pair.second);
@@ -200,7 +431,7 @@ void World::handleCollisions() {
 
             pickup.apply(player);
             pickup.destroy();
-            player.playLocalSound(mCommandQueue, SoundEffect::CollectPickup);
+            player.playLocalSound(SoundEffect::CollectPickup);
         }
         else if (matchesCategories(pair, Category::EnemyAircraft, Category::AlliedProjectile)
 			  || matchesCategories(pair, Category::PlayerAircraft, Category::EnemyProjectile)) {
@@ -211,10 +442,96 @@ void World::handleCollisions() {
             projectile.destroy();
         }
     }
+
+    handleBulletHits();
+}
+
+void World::handleBulletHits() {
+    mSceneRegistry.forEach(Category::BulletSystem, [&] (SceneNode& node) {
+        BulletNode& bullets = static_cast<BulletNode&>(node);
+        unsigned int targets = (bullets.getProjectileType() == Projectile::AlliedBullet) ? Category::EnemyAircraft : Category::PlayerAircraft;
+        const CollisionMask* bulletMask = mCollisionMasks.get(bullets.getSprite(), 0.f);
+
+        // Each aircraft only walks the bullet bands it reaches, a dead bullet or aircraft takes no further hits
+        mSceneRegistry.forEach(targets, [&] (SceneNode& target) {
+            auto& aircraft = static_cast<Aircraft&>(target);
+            if (aircraft.isDestroyed())
+                return;
+
+            sf::FloatRect bounds = aircraft.getBoundingRect();
+            const CollisionMask* mask = mCollisionMasks.get(*aircraft.getCollisionSprite(), aircraft.getRotation());
+
+            bullets.findHits(bounds, [&] (std::size_t index) {
+                if (aircraft.isDestroyed())
+                    return;
+
+                // As with projectile nodes, a hit found only by sweeping skips the pixel test
+                if (mask && bulletMask && bounds.intersects(bullets.getBulletBounds(index))
+                    && !mask->test(aircraft.getWorldPosition(), *bulletMask, bullets.getBulletPosition(index)))
+                    return;
+
+                aircraft.damage(bullets.getDamage());
+                bullets.kill(index);
+            });
+        });
+    });
+}
+
+void World::findCollisionPairs() {
+    // Snapshots are taken first, so grid pointers into colliders stay valid
+    FrameVector<Collider> colliders{ArenaAllocator<Collider>(mFrameArena)};
+    mSceneRegistry.forEach(mCollisionMatrix.getCategories(), [&] (SceneNode& node) {
+        if (!node.isDestroyed())
+            colliders.push_back(makeCollider(node, mCollisionMasks));
+    });
+
+    mCollisionGrid.clear();
+    for (Collider& collider : colliders)
+        mCollisionGrid.insert(collider, collider.sweptBounds, collider.category);
+
+    auto filter = [this] (unsigned int lhs, unsigned int rhs) {
+        return mCollisionMatrix.collides(lhs, rhs);
+    };
+
+    FrameVector<ColliderPair> candidates{ArenaAllocator<ColliderPair>(mFrameArena)};
+    mCollisionGrid.findPairs(filter, [&] (const Collider& lhs, const Collider& rhs) {
+        if (mCollisionMatrix.matches(lhs.category, rhs.category))
+            candidates.emplace_back(&lhs, &rhs);
+        else
+            candidates.emplace_back(&rhs, &lhs);
+    });
+
+    testCollisionPairs(candidates);
+}
+
+void World::testCollisionPairs(const FrameVector<ColliderPair>& candidates) {
+    const std::size_t minPairsPerThread = 256;
+
+    for (auto& hits : mNarrowPhaseHits)
+        hits.clear();
+
+    mThreadPool.parallelFor(candidates.size(), minPairsPerThread, [&] (std::size_t thread, std::size_t begin, std::size_t end) {
+        std::vector<SceneNode::Pair>& hits = mNarrowPhaseHits[thread];
+
+        for (std::size_t i = begin; i < end; ++i) {
+            const ColliderPair& candidate = candidates[i];
+            if (collision(*candidate.first, *candidate.second) && pixelCollision(*candidate.first, *candidate.second))
+                hits.emplace_back(candidate.first->node, candidate.second->node);
+        }
+    });
+
+    // Merged in thread order, then sorted by the contact manager, so thread timing never shows
+    mContacts.beginUpdate();
+    for (const auto& hits : mNarrowPhaseHits)
+        for (const SceneNode::Pair& hit : hits)
+            mContacts.add(*hit.first, *hit.second);
+    mContacts.endUpdate();
 }
 
 void World::updateSounds() {
-    mSounds.setListenerPosition(mPlayerAircraft->getWorldPosition());
+    if (Aircraft* player = getPlayerAircraft())
+        mSounds.setListenerPosition(player->getWorldPosition());
+    mSoundEvents.flush(mSounds);
     mSounds.removeStoppedSounds();
 }
 
@@ -222,7 +539,7 @@ void World::buildScene() {
     for (std::size_t i = 0; i < LayerCount; ++i) {
 		Category::Type category = (i == LowerAir) ? Category::SceneAirLayer : Category::None;
 
-        SceneNode::Ptr layer(new SceneNode(category));
+        NodePool<SceneNode>::Ptr layer = NodePool<SceneNode>::create(category);
         mSceneLayers[i] = layer.get();
 
         mSceneGraph.attachChild(std::move(layer));
@@ -234,28 +551,32 @@ void World::buildScene() {
     float viewHeight = mWorldView.getSize().y;
     textureRect.height += static_cast<int>(viewHeight);
 
-	std::unique_ptr<SpriteNode> backgroundSprite(new SpriteNode(texture, textureRect));
+	NodePool<SpriteNode>::Ptr backgroundSprite = NodePool<SpriteNode>::create(texture, textureRect);
 	backgroundSprite->setPosition(mWorldBounds.left, mWorldBounds.top - viewHeight);
 	mSceneLayers[Background]->attachChild(std::move(backgroundSprite));
 
     sf::Texture& finishTexture = mTextures.get(Textures::FinishLine);
-    std::unique_ptr<SpriteNode> finishSprite(new SpriteNode(finishTexture));
+    NodePool<SpriteNode>::Ptr finishSprite = NodePool<SpriteNode>::create(finishTexture);
     finishSprite->setPosition(0.f, -76.f);
     mSceneLayers[Background]->attachChild(std::move(finishSprite));
 
-    std::unique_ptr<ParticleNode> smokeNode(new ParticleNode(Particle::Smoke, mTextures));
+    NodePool<ParticleNode>::Ptr smokeNode = NodePool<ParticleNode>::create(Particle::Smoke, mTextures);
     mSceneLayers[LowerAir]->attachChild(std::move(smokeNode));
 
-    std::unique_ptr<ParticleNode> propellantNode(new ParticleNode(Particle::Propellant, mTextures));
+    NodePool<ParticleNode>::Ptr propellantNode = NodePool<ParticleNode>::create(Particle::Propellant, mTextures);
     mSceneLayers[LowerAir]->attachChild(std::move(propellantNode));
 
-    std::unique_ptr<SoundNode> soundNode(new SoundNode(mSounds));
-    mSceneGraph.attachChild(std::move(soundNode));
+    NodePool<BulletNode>::Ptr alliedBullets = NodePool<BulletNode>::create(Projectile::AlliedBullet, mTextures);
+    mSceneLayers[LowerAir]->attachChild(std::move(alliedBullets));
+
+    NodePool<BulletNode>::Ptr enemyBullets = NodePool<BulletNode>::create(Projectile::EnemyBullet, mTextures);
+    mSceneLayers[LowerAir]->attachChild(std::move(enemyBullets));
 
-	std::unique_ptr<Aircraft> player(new Aircraft(Aircraft::Eagle, mTextures, mFonts));
-	mPlayerAircraft = player.get();
-	mPlayerAircraft->setPosition(mSpawnPosition);
+	NodePool<Aircraft>::Ptr player = NodePool<Aircraft>::create(Aircraft::Eagle, mTextures, mFonts, mSoundEvents);
+	player->setPosition(mSpawnPosition);
+	Aircraft& playerAircraft = *player;
 	mSceneLayers[UpperAir]->attachChild(std::move(player));
+	mPlayerAircraft = playerAircraft.getHandle();
 
     addEnemies();
 }
@@ -297,10 +618,30 @@ void World::addEnemy(Aircraft::Type type, float relX, float relY) {
     mEnemySpawnPoints.push_back(spawn);
 }
 
+void World::removeWrecks() {
+    // Wrecks left the category buckets when they were marked and are skipped by the scene scans,
+    // so freeing them can wait. Batches are counted in ticks and wrecks, never in wall time
+    std::vector<NodeHandle>& tombstones = mSceneRegistry.getTombstones();
+    if (tombstones.empty())
+        return;
+
+    if (++mTicksSinceCompaction < CompactionInterval && tombstones.size() < WreckBatchSize)
+        return;
+
+    for (NodeHandle tombstone : tombstones) {
+        // Siblings go with the first of them, their handles no longer resolve
+        if (SceneNode* wreck = mSceneRegistry.resolve(tombstone))
+            wreck->getParent()->removeWrecks();
+    }
+
+    tombstones.clear();
+    mTicksSinceCompaction = 0;
+}
+
 void World::spawnEnemies() {
     while(!mEnemySpawnPoints.empty() && mEnemySpawnPoints.back().y > getBattlefieldBounds().top) {
         SpawnPoint spawn = mEnemySpawnPoints.back();
-        std::unique_ptr<Aircraft> enemy(new Aircraft(spawn.type, mTextures, mFonts));
+        NodePool<Aircraft>::Ptr enemy = NodePool<Aircraft>::create(spawn.type, mTextures, mFonts, mSoundEvents);
         enemy->setPosition(spawn.x, spawn.y);
         enemy->setRotation(180.f);
 
@@ -309,28 +650,50 @@ void World::spawnEnemies() {
     }
 }
 
-void World::destroyEntitiesOutsideView() {
-    Command command;
-    command.category = Category::Projectile | Category::EnemyAircraft;
-    command.action = derivedAction<Entity>([this] (Entity& e, sf::Time) {
-        if (!getBattlefieldBounds().intersects(e.getBoundingRect())) {
-            e.destroy();
-        }
+void World::dispatchCommand(const Command& command, sf::Time dt) {
+    // Only the buckets of the command's categories are walked, the wrecks in them are skipped
+    CommandProfiler::Timer timer;
+    std::size_t matched = 0;
+
+    std::size_t visited = mSceneRegistry.forEach(command.category, [&] (SceneNode& node) {
+        command.action(node, dt);
+        ++matched;
     });
 
-    mCommandQueue.push(command);
+    mCommandProfiler.record(command, visited, matched, timer.getElapsedTime());
 }
 
-void World::guideMissiles() {
-    Command enemyCollector;
-    enemyCollector.category = Category::EnemyAircraft;
-    enemyCollector.action = derivedAction<Aircraft>([this] (Aircraft& enemy, sf::Time) {
-        if (!enemy.isDestroyed())
-            mActiveEnemies.push_back(&enemy);
+void World::destroyEntitiesOutsideView() {
+    FrameVector<Entity*> candidates{ArenaAllocator<Entity*>(mFrameArena)};
+    mViewCandidateBounds.clear();
+
+    mSceneRegistry.forEach(Category::Projectile | Category::EnemyAircraft, [&] (SceneNode& node) {
+        Entity& entity = static_cast<Entity&>(node);
+        candidates.push_back(&entity);
+        mViewCandidateBounds.push(entity.getBoundingRect());
+    });
+
+    // Hits arrive in index order, everything skipped in between is outside the battlefield
+    std::size_t next = 0;
+    mViewCandidateBounds.intersect(getBattlefieldBounds(), 0, candidates.size(), [&] (std::size_t hit) {
+        for (; next < hit; ++next)
+            candidates[next]->destroy();
+        next = hit + 1;
     });
 
+    for (; next < candidates.size(); ++next)
+        candidates[next]->destroy();
+
+    mSceneRegistry.forEach(Category::BulletSystem, [&] (SceneNode& node) {
+        static_cast<BulletNode&>(node).cull(getBattlefieldBounds());
+    });
+}
+
+void World::guideMissiles() {
+    // mActiveEnemies follows spawn and destroy events
     Command missileGuider;
     missileGuider.category = Category::AlliedProjectile;
+    missileGuider.origin = "World::guideMissiles guide";
     missileGuider.action = derivedAction<Projectile>([this] (Projectile& missile, sf::Time) {
         if (!missile.isGuided())
             return;
@@ -338,7 +701,11 @@ void World::guideMissiles() {
         float minDistance = std::numeric_limits<float>::max();
         Aircraft* closestEnemy = nullptr;
 
-        for (Aircraft* enemy : mActiveEnemies) {
+        for (NodeHandle handle : mActiveEnemies) {
+            Aircraft* enemy = mSceneRegistry.resolve<Aircraft>(handle);
+            if (!enemy)
+                continue;
+
             float enemyDistance = distance(missile, *enemy);
 
             if (enemyDistance < minDistance) {
@@ -351,9 +718,22 @@ void World::guideMissiles() {
             missile.guideTowards(closestEnemy->getWorldPosition());
     });
 
-    mCommandQueue.push(enemyCollector);
     mCommandQueue.push(missileGuider);
-    mActiveEnemies.clear();
+}
+
+Aircraft* World::getPlayerAircraft() const {
+    return mSceneRegistry.resolve<Aircraft>(mPlayerAircraft);
+}
+
+void World::checkPlayerReachedEnd() {
+    Aircraft* player = getPlayerAircraft();
+    if (!player)
+        return;
+
+    if (!mPlayerReachedEnd && !mWorldBounds.contains(player->getPosition())) {
+        mPlayerReachedEnd = true;
+        mEventBus.publish(PlayerReachedEnd());
+    }
 }
 
 sf::FloatRect World::getViewBounds() const {
@@ -5,12 +5,16 @@
 #include "Game/Player.hpp"
 #include "Effects/MusicPlayer.hpp"
 
+#include <iostream>
+
 class GameState : public State {
     public:
         GameState(StateStack& stack, Context context);
         virtual void draw();
         virtual bool update(sf::Time dt);
         virtual bool handleEvent(const sf::Event& event);
+        void onEvent(const PlayerDied& event);
+        void onEvent(const PlayerReachedEnd& event);
     private:
         World mWorld;
         Player& mPlayer;
@@ -19,6 +23,8 @@ class GameState : public State {
 GameState::GameState(StateStack& stack, Context context)
 : State(stack, context), mWorld(*context.window, *context.fonts, *context.sounds), mPlayer(*context.player) {
     mPlayer.setMissionStatus(Player::MissionRunning);
+    mWorld.getEventBus().subscribe<PlayerDied>(*this);
+    mWorld.getEventBus().subscribe<PlayerReachedEnd>(*this);
     context.music->play(Music::MissionTheme);
 }
 
@@ -27,27 +33,36 @@ void GameState::draw() {
 }
 
 bool GameState::update(sf::Time dt) {
+    mPlayer.handleRealtimeInput();
+    mWorld.setPlayerInput(mPlayer.popInput());
     mWorld.update(dt);
 
-    if(!mWorld.hasAlivePlayer()) {
-		mPlayer.setMissionStatus(Player::MissionFailure);
-		requestStackPush(States::GameOver);
-	}
-	else if(mWorld.hasPlayerReachedEnd()) {
-		mPlayer.setMissionStatus(Player::MissionSuccess);
-		requestStackPush(States::GameOver);
-	}
-
-    CommandQueue& commands = mWorld.getCommandQueue();
-    mPlayer.handleRealtimeInput(commands);
-
     return true;
 }
 
 bool GameState::handleEvent(const sf::Event& event) {
-    CommandQueue& commands = mWorld.getCommandQueue();
-    mPlayer.handleEvent(event, commands);
+    mPlayer.handleEvent(event);
     if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
         requestStackPush(States::Pause);
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+        mWorld.getCommandProfiler().report(std::cout);
+        mWorld.reportMemory(std::cout);
+    }
     return true;
 }
+
+void GameState::onEvent(const PlayerDied&) {
+    if (mPlayer.getMissionStatus() != Player::MissionRunning)
+        return;
+
+    mPlayer.setMissionStatus(Player::MissionFailure);
+    requestStackPush(States::GameOver);
+}
+
+void GameState::onEvent(const PlayerReachedEnd&) {
+    if (mPlayer.getMissionStatus() != Player::MissionRunning)
+        return;
+
+    mPlayer.setMissionStatus(Player::MissionSuccess);
+    requestStackPush(States::GameOver);
+}
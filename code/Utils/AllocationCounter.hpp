@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdlib>
+#include <new>
+
+// With DESERT_RAID_COUNT_ALLOCS the global operator new is replaced, so a tick can check it
+// never reached the general heap. Only allocations made inside a Scope, on its own thread, count.
+namespace AllocationCounter {
+    class Scope {
+        public:
+            Scope();
+            ~Scope();
+        private:
+            bool mWasEnabled;
+    };
+
+    bool isEnabled();
+    std::size_t getCount();
+
+    #if defined(DESERT_RAID_COUNT_ALLOCS)
+    thread_local bool counting = false;
+    thread_local std::size_t count = 0;
+    #endif
+}
+
+AllocationCounter::Scope::Scope()
+: mWasEnabled(false) {
+    #if defined(DESERT_RAID_COUNT_ALLOCS)
+    mWasEnabled = counting;
+    counting = true;
+    #endif
+}
+
+AllocationCounter::Scope::~Scope() {
+    #if defined(DESERT_RAID_COUNT_ALLOCS)
+    counting = mWasEnabled;
+    #endif
+}
+
+bool AllocationCounter::isEnabled() {
+    #if defined(DESERT_RAID_COUNT_ALLOCS)
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+std::size_t AllocationCounter::getCount() {
+    #if defined(DESERT_RAID_COUNT_ALLOCS)
+    return count;
+    #else
+    return 0;
+    #endif
+}
+
+#if defined(DESERT_RAID_COUNT_ALLOCS)
+void* operator new(std::size_t size) {
+    if (AllocationCounter::counting)
+        ++AllocationCounter::count;
+
+    if (void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+#endif
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Utils/Utility.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+#include <tuple>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+class CollisionMask {
+    public:
+        CollisionMask();
+        CollisionMask(const sf::Image& image, const sf::IntRect& rect, sf::Vector2f origin);
+        CollisionMask rotated(float degrees) const;
+        bool test(sf::Vector2f position, const CollisionMask& other, sf::Vector2f otherPosition) const;
+        sf::Vector2i getSize() const;
+    private:
+        explicit CollisionMask(sf::Vector2i size);
+        bool get(int x, int y) const;
+        void set(int x, int y);
+        std::uint64_t getBits(int row, int column) const;
+    private:
+        sf::Vector2i mSize;
+        std::size_t mWordsPerRow;
+        sf::Vector2f mOrigin;
+        std::vector<std::uint64_t> mBits;
+};
+
+class CollisionMaskHolder {
+    public:
+        void load(const sf::Texture& texture, const std::vector<sf::IntRect>& rects);
+        void load(const sf::Image& image, const std::vector<sf::IntRect>& rects);
+        const CollisionMask* get(const sf::Sprite& sprite, float rotation) const;
+    private:
+        typedef std::tuple<int, int, int, int> Key;
+
+        // Every rotation step of one texture rect, stored contiguously from first
+        struct Entry {
+            Key key;
+            std::size_t first;
+        };
+
+        static Key toKey(const sf::IntRect& rect);
+    private:
+        static const int RotationSteps = 64;
+        std::vector<Entry> mEntries;
+        std::vector<CollisionMask> mMasks;
+};
+
+CollisionMask::CollisionMask()
+: mSize(), mWordsPerRow(0), mOrigin(), mBits() {
+}
+
+CollisionMask::CollisionMask(sf::Vector2i size)
+: mSize(size), mWordsPerRow((size.x + 63) / 64), mOrigin(), mBits(mWordsPerRow * size.y) {
+}
+
+CollisionMask::CollisionMask(const sf::Image& image, const sf::IntRect& rect, sf::Vector2f origin)
+: CollisionMask(sf::Vector2i(rect.width, rect.height)) {
+    const sf::Uint8 alphaThreshold = 128;
+
+    mOrigin = origin;
+    for (int y = 0; y < rect.height; ++y)
+        for (int x = 0; x < rect.width; ++x)
+            if (image.getPixel(rect.left + x, rect.top + y).a >= alphaThreshold)
+                set(x, y);
+}
+
+CollisionMask CollisionMask::rotated(float degrees) const {
+    float radians = Utility::toRadian(degrees);
+    float cos = std::cos(radians);
+    float sin = std::sin(radians);
+
+    sf::Vector2f min(0.f, 0.f);
+    sf::Vector2f max(0.f, 0.f);
+    const sf::Vector2f corners[] = {
+        -mOrigin,
+        sf::Vector2f(mSize.x - mOrigin.x, -mOrigin.y),
+        sf::Vector2f(-mOrigin.x, mSize.y - mOrigin.y),
+        sf::Vector2f(mSize) - mOrigin
+    };
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        sf::Vector2f corner(corners[i].x * cos - corners[i].y * sin, corners[i].x * sin + corners[i].y * cos);
+        min = sf::Vector2f(std::min(min.x, corner.x), std::min(min.y, corner.y));
+        max = sf::Vector2f(std::max(max.x, corner.x), std::max(max.y, corner.y));
+    }
+
+    min = sf::Vector2f(std::floor(min.x), std::floor(min.y));
+    max = sf::Vector2f(std::ceil(max.x), std::ceil(max.y));
+
+    CollisionMask result(sf::Vector2i(max - min));
+    result.mOrigin = -min;
+
+    // Sample the source at the centre of every destination pixel
+    for (int y = 0; y < result.mSize.y; ++y) {
+        for (int x = 0; x < result.mSize.x; ++x) {
+            sf::Vector2f target(x + 0.5f + min.x, y + 0.5f + min.y);
+            sf::Vector2f source(target.x * cos + target.y * sin + mOrigin.x, -target.x * sin + target.y * cos + mOrigin.y);
+
+            if (get(static_cast<int>(std::floor(source.x)), static_cast<int>(std::floor(source.y))))
+                result.set(x, y);
+        }
+    }
+
+    return result;
+}
+
+bool CollisionMask::test(sf::Vector2f position, const CollisionMask& other, sf::Vector2f otherPosition) const {
+    sf::Vector2f topLeft = position - mOrigin;
+    sf::Vector2f otherTopLeft = otherPosition - other.mOrigin;
+    int offsetX = static_cast<int>(std::round(otherTopLeft.x - topLeft.x));
+    int offsetY = static_cast<int>(std::round(otherTopLeft.y - topLeft.y));
+
+    int firstRow = std::max(0, offsetY);
+    int lastRow = std::min(mSize.y, offsetY + other.mSize.y);
+
+    for (int y = firstRow; y < lastRow; ++y) {
+        const std::uint64_t* row = &mBits[y * mWordsPerRow];
+
+        for (std::size_t word = 0; word < mWordsPerRow; ++word) {
+            if (row[word] & other.getBits(y - offsetY, static_cast<int>(word) * 64 - offsetX))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+sf::Vector2i CollisionMask::getSize() const {
+    return mSize;
+}
+
+bool CollisionMask::get(int x, int y) const {
+    if (x < 0 || y < 0 || x >= mSize.x || y >= mSize.y)
+        return false;
+
+    return (mBits[y * mWordsPerRow + x / 64] >> (x % 64)) & 1u;
+}
+
+void CollisionMask::set(int x, int y) {
+    mBits[y * mWordsPerRow + x / 64] |= std::uint64_t(1) << (x % 64);
+}
+
+std::uint64_t CollisionMask::getBits(int row, int column) const {
+    // 64 bits of the row starting at column, which may lie outside the mask
+    int word = (column >= 0) ? column / 64 : -((63 - column) / 64);
+    int shift = column - word * 64;
+    const std::uint64_t* bits = &mBits[row * mWordsPerRow];
+
+    std::uint64_t low = (word >= 0 && word < static_cast<int>(mWordsPerRow)) ? bits[word] : 0;
+    std::uint64_t high = (word + 1 >= 0 && word + 1 < static_cast<int>(mWordsPerRow)) ? bits[word + 1] : 0;
+
+    if (shift == 0)
+        return low;
+
+    return (low >> shift) | (high << (64 - shift));
+}
+
+void CollisionMaskHolder::load(const sf::Texture& texture, const std::vector<sf::IntRect>& rects) {
+    load(texture.copyToImage(), rects);
+}
+
+void CollisionMaskHolder::load(const sf::Image& image, const std::vector<sf::IntRect>& rects) {
+    for (const sf::IntRect& rect : rects) {
+        Key key = toKey(rect);
+        if (std::any_of(mEntries.begin(), mEntries.end(), [&](const Entry& entry) { return entry.key == key; }))
+            continue;
+
+        // Sprites are centred with Utility::centerOrigin
+        sf::Vector2f origin(std::floor(rect.width / 2.f), std::floor(rect.height / 2.f));
+        CollisionMask upright(image, rect, origin);
+
+        // All rotations are derived from the upright mask here, lookups never build one
+        mEntries.push_back({key, mMasks.size()});
+        mMasks.push_back(upright);
+        for (int step = 1; step < RotationSteps; ++step)
+            mMasks.push_back(upright.rotated(step * 360.f / RotationSteps));
+    }
+
+    std::sort(mEntries.begin(), mEntries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.key < rhs.key; });
+}
+
+const CollisionMask* CollisionMaskHolder::get(const sf::Sprite& sprite, float rotation) const {
+    Key key = toKey(sprite.getTextureRect());
+    auto found = std::lower_bound(mEntries.begin(), mEntries.end(), key, [](const Entry& entry, const Key& key) { return entry.key < key; });
+    if (found == mEntries.end() || found->key != key)
+        return nullptr;
+
+    int step = static_cast<int>(std::round(rotation / 360.f * RotationSteps)) % RotationSteps;
+    if (step < 0)
+        step += RotationSteps;
+
+    return &mMasks[found->first + step];
+}
+
+CollisionMaskHolder::Key CollisionMaskHolder::toKey(const sf::IntRect& rect) {
+    return Key(rect.left, rect.top, rect.width, rect.height);
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <SFML/System.hpp>
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+// Bump allocator for data that lives for one tick, everything is released at once by reset
+class FrameArena : private sf::NonCopyable {
+    public:
+        explicit FrameArena(std::size_t capacity);
+        void* allocate(std::size_t size, std::size_t alignment);
+        void deallocate(void* pointer, std::size_t size);
+        void reset();
+        std::size_t getUsed() const;
+        std::size_t getPeak() const;
+        std::size_t getCapacity() const;
+    private:
+        struct Block {
+            std::unique_ptr<unsigned char[]> memory;
+            std::size_t size;
+        };
+    private:
+        void addBlock(std::size_t size);
+    private:
+        std::vector<Block> mBlocks;
+        std::size_t mBlock;
+        std::size_t mOffset;
+        std::size_t mUsedInEarlierBlocks;
+        std::size_t mPeak;
+};
+
+// Lets standard containers take their storage from a FrameArena, deallocation is a no-op
+template <typename T>
+class ArenaAllocator {
+    public:
+        typedef T value_type;
+    public:
+        explicit ArenaAllocator(FrameArena& arena);
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other);
+
+        T* allocate(std::size_t count);
+        void deallocate(T* pointer, std::size_t count);
+        FrameArena& getArena() const;
+    private:
+        FrameArena* mArena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+FrameArena::FrameArena(std::size_t capacity)
+: mBlocks(), mBlock(0), mOffset(0), mUsedInEarlierBlocks(0), mPeak(0) {
+    addBlock(capacity);
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    while (true) {
+        Block& block = mBlocks[mBlock];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+        std::size_t begin = ((base + mOffset + alignment - 1) & ~(alignment - 1)) - base;
+
+        if (begin + size <= block.size) {
+            mOffset = begin + size;
+            mPeak = std::max(mPeak, getUsed());
+            return block.memory.get() + begin;
+        }
+
+        // Spills into a new block this tick, reset merges the blocks so the next tick fits in one
+        mUsedInEarlierBlocks += mOffset;
+        mOffset = 0;
+        if (++mBlock == mBlocks.size())
+            addBlock(std::max(block.size, size + alignment));
+    }
+}
+
+void FrameArena::deallocate(void* pointer, std::size_t size) {
+    // Only the newest allocation can be handed back, a growing vector's old buffer usually is
+    unsigned char* end = static_cast<unsigned char*>(pointer) + size;
+    if (end == mBlocks[mBlock].memory.get() + mOffset)
+        mOffset -= size;
+}
+
+void FrameArena::reset() {
+    if (mBlocks.size() > 1) {
+        std::size_t capacity = getCapacity();
+        mBlocks.clear();
+        addBlock(capacity);
+    }
+
+    mBlock = 0;
+    mOffset = 0;
+    mUsedInEarlierBlocks = 0;
+}
+
+std::size_t FrameArena::getUsed() const {
+    return mUsedInEarlierBlocks + mOffset;
+}
+
+std::size_t FrameArena::getPeak() const {
+    return mPeak;
+}
+
+std::size_t FrameArena::getCapacity() const {
+    std::size_t capacity = 0;
+    for (const Block& block : mBlocks)
+        capacity += block.size;
+    return capacity;
+}
+
+void FrameArena::addBlock(std::size_t size) {
+    mBlocks.push_back(Block{std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+}
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(FrameArena& arena)
+: mArena(&arena) {
+}
+
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& other)
+: mArena(&other.getArena()) {
+}
+
+template <typename T>
+T* ArenaAllocator<T>::allocate(std::size_t count) {
+    return static_cast<T*>(mArena->allocate(count * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void ArenaAllocator<T>::deallocate(T* pointer, std::size_t count) {
+    mArena->deallocate(pointer, count * sizeof(T));
+}
+
+template <typename T>
+FrameArena& ArenaAllocator<T>::getArena() const {
+    return *mArena;
+}
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return &lhs.getArena() == &rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
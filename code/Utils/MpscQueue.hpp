@@ -0,0 +1,105 @@
+#pragma once
+
+#include <SFML/System.hpp>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <cstddef>
+
+// Bounded multi-producer single-consumer ring (Vyukov), push never blocks, allocates or takes a lock
+template <typename T>
+class MpscQueue : private sf::NonCopyable {
+    public:
+        explicit MpscQueue(std::size_t capacity);
+        bool push(const T& value);
+        bool push(T&& value);
+        bool tryPop(T& value);
+        std::size_t getCapacity() const;
+    private:
+        // A cell is free for the producer at position when sequence == position,
+        // and holds a value for the consumer at position when sequence == position + 1
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+    private:
+        template <typename Value>
+        bool emplace(Value&& value);
+    private:
+        std::unique_ptr<Cell[]> mCells;
+        std::size_t mMask;
+        // Producers and the consumer write different cache lines
+        alignas(64) std::atomic<std::size_t> mHead;
+        alignas(64) std::size_t mTail;
+};
+
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity)
+: mCells(), mMask(0), mHead(0), mTail(0) {
+    // Power of two capacity, so wrapping is a mask
+    std::size_t cells = 2;
+    while (cells < capacity)
+        cells *= 2;
+
+    mCells.reset(new Cell[cells]);
+    mMask = cells - 1;
+    for (std::size_t i = 0; i < cells; ++i)
+        mCells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool MpscQueue<T>::push(const T& value) {
+    return emplace(value);
+}
+
+template <typename T>
+bool MpscQueue<T>::push(T&& value) {
+    return emplace(std::move(value));
+}
+
+template <typename T>
+bool MpscQueue<T>::tryPop(T& value) {
+    // Consumer only. A producer between its claim and publish is picked up by a later pop
+    Cell& cell = mCells[mTail & mMask];
+    if (cell.sequence.load(std::memory_order_acquire) != mTail + 1)
+        return false;
+
+    value = std::move(cell.value);
+    cell.sequence.store(mTail + mMask + 1, std::memory_order_release);
+    ++mTail;
+    return true;
+}
+
+template <typename T>
+std::size_t MpscQueue<T>::getCapacity() const {
+    return mMask + 1;
+}
+
+template <typename T>
+template <typename Value>
+bool MpscQueue<T>::emplace(Value&& value) {
+    std::size_t position = mHead.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    for (;;) {
+        cell = &mCells[position & mMask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0) {
+            // The cell is free, claim the position before another producer does
+            if (mHead.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        } else if (difference < 0) {
+            // The consumer has not freed the cell of the previous lap, the ring is full
+            return false;
+        } else {
+            position = mHead.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->value = std::forward<Value>(value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+
+// SSE2 is part of every x86-64 target, other targets fall back to one rect at a time
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RECTBATCH_SSE2
+#endif
+
+// Rects stored as separate left/top/right/bottom lanes, tested several at a time
+class RectBatch {
+    public:
+        #if defined(RECTBATCH_SSE2)
+        static const std::size_t Lanes = 4;
+        #else
+        static const std::size_t Lanes = 1;
+        #endif
+    public:
+        RectBatch();
+        void clear();
+        void push(const sf::FloatRect& rect);
+        std::size_t size() const;
+
+        template <typename Function>
+        void intersect(const sf::FloatRect& rect, std::size_t begin, std::size_t end, Function fn) const;
+
+        template <typename Function>
+        void intersectScalar(const sf::FloatRect& rect, std::size_t begin, std::size_t end, Function fn) const;
+    private:
+        std::uint32_t testBlock(const sf::FloatRect& rect, std::size_t index) const;
+        void pad();
+    private:
+        std::vector<float> mLefts;
+        std::vector<float> mTops;
+        std::vector<float> mRights;
+        std::vector<float> mBottoms;
+        std::size_t mSize;
+};
+
+RectBatch::RectBatch()
+: mLefts(), mTops(), mRights(), mBottoms(), mSize(0) {
+    pad();
+}
+
+void RectBatch::clear() {
+    mLefts.clear();
+    mTops.clear();
+    mRights.clear();
+    mBottoms.clear();
+    mSize = 0;
+    pad();
+}
+
+void RectBatch::push(const sf::FloatRect& rect) {
+    // The slot after the last rect is padding, overwrite it and pad again
+    mLefts[mSize] = rect.left;
+    mTops[mSize] = rect.top;
+    mRights[mSize] = rect.left + rect.width;
+    mBottoms[mSize] = rect.top + rect.height;
+    ++mSize;
+
+    mLefts.push_back(std::numeric_limits<float>::max());
+    mTops.push_back(std::numeric_limits<float>::max());
+    mRights.push_back(std::numeric_limits<float>::lowest());
+    mBottoms.push_back(std::numeric_limits<float>::lowest());
+}
+
+std::size_t RectBatch::size() const {
+    return mSize;
+}
+
+template <typename Function>
+void RectBatch::intersect(const sf::FloatRect& rect, std::size_t begin, std::size_t end, Function fn) const {
+    for (std::size_t index = begin; index < end; index += Lanes) {
+        std::uint32_t hits = testBlock(rect, index);
+        if (end - index < Lanes)
+            hits &= (1u << (end - index)) - 1u;
+
+        for (std::size_t lane = 0; hits != 0; ++lane, hits >>= 1)
+            if (hits & 1u)
+                fn(index + lane);
+    }
+}
+
+template <typename Function>
+void RectBatch::intersectScalar(const sf::FloatRect& rect, std::size_t begin, std::size_t end, Function fn) const {
+    float right = rect.left + rect.width;
+    float bottom = rect.top + rect.height;
+
+    for (std::size_t index = begin; index < end; ++index)
+        if (rect.left < mRights[index] && mLefts[index] < right && rect.top < mBottoms[index] && mTops[index] < bottom)
+            fn(index);
+}
+
+std::uint32_t RectBatch::testBlock(const sf::FloatRect& rect, std::size_t index) const {
+    // Same strict test as sf::FloatRect::intersects for rects of positive size
+    #if defined(RECTBATCH_SSE2)
+    __m128 hit = _mm_and_ps(
+        _mm_and_ps(_mm_cmplt_ps(_mm_set1_ps(rect.left), _mm_loadu_ps(&mRights[index])),
+                   _mm_cmplt_ps(_mm_loadu_ps(&mLefts[index]), _mm_set1_ps(rect.left + rect.width))),
+        _mm_and_ps(_mm_cmplt_ps(_mm_set1_ps(rect.top), _mm_loadu_ps(&mBottoms[index])),
+                   _mm_cmplt_ps(_mm_loadu_ps(&mTops[index]), _mm_set1_ps(rect.top + rect.height))));
+    return static_cast<std::uint32_t>(_mm_movemask_ps(hit));
+    #else
+    return (rect.left < mRights[index] && mLefts[index] < rect.left + rect.width
+        && rect.top < mBottoms[index] && mTops[index] < rect.top + rect.height) ? 1u : 0u;
+    #endif
+}
+
+void RectBatch::pad() {
+    // A full block can always be loaded past the last rect, the padding never intersects
+    while (mLefts.size() < mSize + Lanes) {
+        mLefts.push_back(std::numeric_limits<float>::max());
+        mTops.push_back(std::numeric_limits<float>::max());
+        mRights.push_back(std::numeric_limits<float>::lowest());
+        mBottoms.push_back(std::numeric_limits<float>::lowest());
+    }
+}
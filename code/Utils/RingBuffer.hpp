@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <cassert>
+
+// Contiguous FIFO whose capacity only grows, slots are reused once popped
+template <typename T>
+class RingBuffer {
+    public:
+        explicit RingBuffer(std::size_t capacity = 16);
+        void push(const T& value);
+        void push(T&& value);
+        T pop();
+        T& front();
+        void clear();
+        bool isEmpty() const;
+        std::size_t getSize() const;
+        std::size_t getCapacity() const;
+        void swap(RingBuffer& other);
+    private:
+        void grow();
+    private:
+        std::vector<T> mSlots;
+        std::size_t mHead;
+        std::size_t mSize;
+};
+
+template <typename T>
+RingBuffer<T>::RingBuffer(std::size_t capacity)
+: mSlots(), mHead(0), mSize(0) {
+    // Power of two capacity, so wrapping is a mask
+    std::size_t slots = 1;
+    while (slots < capacity)
+        slots *= 2;
+
+    mSlots.resize(slots);
+}
+
+template <typename T>
+void RingBuffer<T>::push(const T& value) {
+    push(T(value));
+}
+
+template <typename T>
+void RingBuffer<T>::push(T&& value) {
+    if (mSize == mSlots.size())
+        grow();
+
+    mSlots[(mHead + mSize) & (mSlots.size() - 1)] = std::move(value);
+    ++mSize;
+}
+
+template <typename T>
+T RingBuffer<T>::pop() {
+    assert(!isEmpty());
+
+    T value = std::move(mSlots[mHead]);
+    mHead = (mHead + 1) & (mSlots.size() - 1);
+    --mSize;
+    return value;
+}
+
+template <typename T>
+T& RingBuffer<T>::front() {
+    assert(!isEmpty());
+    return mSlots[mHead];
+}
+
+template <typename T>
+void RingBuffer<T>::clear() {
+    while (!isEmpty())
+        pop();
+
+    mHead = 0;
+}
+
+template <typename T>
+bool RingBuffer<T>::isEmpty() const {
+    return mSize == 0;
+}
+
+template <typename T>
+std::size_t RingBuffer<T>::getSize() const {
+    return mSize;
+}
+
+template <typename T>
+std::size_t RingBuffer<T>::getCapacity() const {
+    return mSlots.size();
+}
+
+template <typename T>
+void RingBuffer<T>::swap(RingBuffer& other) {
+    mSlots.swap(other.mSlots);
+    std::swap(mHead, other.mHead);
+    std::swap(mSize, other.mSize);
+}
+
+template <typename T>
+void RingBuffer<T>::grow() {
+    std::vector<T> slots(mSlots.size() * 2);
+    for (std::size_t i = 0; i < mSize; ++i)
+        slots[i] = std::move(mSlots[(mHead + i) & (mSlots.size() - 1)]);
+
+    mSlots.swap(slots);
+    mHead = 0;
+}
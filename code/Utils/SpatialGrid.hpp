@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Utils/RectBatch.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cassert>
+
+template <typename T>
+class SpatialGrid {
+    public:
+        explicit SpatialGrid(sf::Vector2f cellSize);
+        void clear();
+        void insert(T& item, const sf::FloatRect& bounds, unsigned int mask);
+
+        template <typename Filter, typename Function>
+        void findPairs(Filter filter, Function fn);
+
+        std::size_t getItemCount() const;
+    private:
+        struct Item {
+            T* item;
+            sf::FloatRect bounds;
+            unsigned int mask;
+        };
+
+        struct Entry {
+            std::uint64_t cell;
+            std::size_t item;
+        };
+    private:
+        sf::Vector2i getCell(float x, float y) const;
+        static std::uint64_t hashCell(int x, int y);
+    private:
+        sf::Vector2f mCellSize;
+        std::vector<Item> mItems;
+        std::vector<Entry> mEntries;
+        RectBatch mEntryBounds;
+};
+
+template <typename T>
+SpatialGrid<T>::SpatialGrid(sf::Vector2f cellSize)
+: mCellSize(cellSize), mItems(), mEntries(), mEntryBounds() {
+    assert(cellSize.x > 0.f && cellSize.y > 0.f);
+}
+
+template <typename T>
+void SpatialGrid<T>::clear() {
+    // Keep the capacity, the grid is refilled every frame
+    mItems.clear();
+    mEntries.clear();
+    mEntryBounds.clear();
+}
+
+template <typename T>
+void SpatialGrid<T>::insert(T& item, const sf::FloatRect& bounds, unsigned int mask) {
+    if (bounds.width <= 0.f || bounds.height <= 0.f)
+        return;
+
+    std::size_t index = mItems.size();
+    mItems.push_back(Item{&item, bounds, mask});
+
+    sf::Vector2i first = getCell(bounds.left, bounds.top);
+    sf::Vector2i last = getCell(bounds.left + bounds.width, bounds.top + bounds.height);
+
+    for (int x = first.x; x <= last.x; ++x)
+        for (int y = first.y; y <= last.y; ++y)
+            mEntries.push_back(Entry{hashCell(x, y), index});
+}
+
+template <typename T>
+template <typename Filter, typename Function>
+void SpatialGrid<T>::findPairs(Filter filter, Function fn) {
+    std::sort(mEntries.begin(), mEntries.end(), [] (const Entry& lhs, const Entry& rhs) {
+        return lhs.cell < rhs.cell || (lhs.cell == rhs.cell && lhs.item < rhs.item);
+    });
+
+    // Bounds follow the sorted entries, so a cell's run is a contiguous batch
+    mEntryBounds.clear();
+    for (const Entry& entry : mEntries)
+        mEntryBounds.push(mItems[entry.item].bounds);
+
+    for (std::size_t runBegin = 0; runBegin < mEntries.size();) {
+        std::uint64_t cell = mEntries[runBegin].cell;
+        std::size_t runEnd = runBegin + 1;
+        while (runEnd < mEntries.size() && mEntries[runEnd].cell == cell)
+            ++runEnd;
+
+        for (std::size_t i = runBegin; i < runEnd; ++i) {
+            const Item& first = mItems[mEntries[i].item];
+            const sf::FloatRect& lhs = first.bounds;
+
+            mEntryBounds.intersect(lhs, i + 1, runEnd, [&] (std::size_t j) {
+                const Item& second = mItems[mEntries[j].item];
+                const sf::FloatRect& rhs = second.bounds;
+
+                if (!filter(first.mask, second.mask))
+                    return;
+
+                // A pair spanning several cells is reported only by the cell owning the overlap's top-left corner
+                sf::Vector2i owner = getCell(std::max(lhs.left, rhs.left), std::max(lhs.top, rhs.top));
+                if (hashCell(owner.x, owner.y) == cell)
+                    fn(*first.item, *second.item);
+            });
+        }
+
+        runBegin = runEnd;
+    }
+}
+
+template <typename T>
+std::size_t SpatialGrid<T>::getItemCount() const {
+    return mItems.size();
+}
+
+template <typename T>
+sf::Vector2i SpatialGrid<T>::getCell(float x, float y) const {
+    return sf::Vector2i(static_cast<int>(std::floor(x / mCellSize.x)), static_cast<int>(std::floor(y / mCellSize.y)));
+}
+
+template <typename T>
+std::uint64_t SpatialGrid<T>::hashCell(int x, int y) {
+    // Shifted as unsigned, cells left of or above the origin have negative coordinates
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <SFML/System.hpp>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+class ThreadPool : private sf::NonCopyable {
+    public:
+        explicit ThreadPool(std::size_t workerCount);
+        ~ThreadPool();
+        std::size_t getThreadCount() const;
+
+        template <typename Function>
+        void parallelFor(std::size_t count, std::size_t minPerThread, Function fn);
+    private:
+        void runWorker(std::size_t thread);
+
+        template <typename Task>
+        static void invoke(void* task, std::size_t thread);
+    private:
+        std::vector<std::thread> mWorkers;
+        std::mutex mMutex;
+        std::condition_variable mWakeUp;
+        std::condition_variable mDone;
+        void (*mTask)(void*, std::size_t);
+        void* mTaskContext;
+        std::size_t mActiveThreads;
+        std::size_t mPending;
+        std::size_t mGeneration;
+        bool mStop;
+};
+
+ThreadPool::ThreadPool(std::size_t workerCount)
+: mWorkers(), mMutex(), mWakeUp(), mDone(), mTask(nullptr), mTaskContext(nullptr),
+mActiveThreads(0), mPending(0), mGeneration(0), mStop(false) {
+    // Worker 0 is the calling thread
+    for (std::size_t thread = 1; thread <= workerCount; ++thread)
+        mWorkers.emplace_back(&ThreadPool::runWorker, this, thread);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWakeUp.notify_all();
+
+    for (std::thread& worker : mWorkers)
+        worker.join();
+}
+
+std::size_t ThreadPool::getThreadCount() const {
+    return mWorkers.size() + 1;
+}
+
+template <typename Function>
+void ThreadPool::parallelFor(std::size_t count, std::size_t minPerThread, Function fn) {
+    std::size_t threads = std::min(getThreadCount(), std::max<std::size_t>(1, count / std::max<std::size_t>(1, minPerThread)));
+
+    // Ranges depend only on count and thread count, so every run splits the work the same way
+    auto task = [&] (std::size_t thread) {
+        fn(thread, count * thread / threads, count * (thread + 1) / threads);
+    };
+
+    if (threads == 1) {
+        task(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = &ThreadPool::invoke<decltype(task)>;
+        mTaskContext = &task;
+        mActiveThreads = threads;
+        mPending = threads - 1;
+        ++mGeneration;
+    }
+    mWakeUp.notify_all();
+
+    task(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this] { return mPending == 0; });
+    mTask = nullptr;
+    mTaskContext = nullptr;
+}
+
+void ThreadPool::runWorker(std::size_t thread) {
+    std::size_t generation = 0;
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true) {
+        mWakeUp.wait(lock, [&] { return mStop || mGeneration != generation; });
+        if (mStop)
+            return;
+
+        generation = mGeneration;
+        if (thread >= mActiveThreads)
+            continue;
+
+        void (*task)(void*, std::size_t) = mTask;
+        void* context = mTaskContext;
+
+        lock.unlock();
+        task(context, thread);
+        lock.lock();
+
+        if (--mPending == 0)
+            mDone.notify_one();
+    }
+}
+
+template <typename Task>
+void ThreadPool::invoke(void* task, std::size_t thread) {
+    (*static_cast<Task*>(task))(thread);
+}
@@ -174,4 +174,43 @@ sf::Vector2f unitVector(sf::Vector2f vector) {
 	return vector / length(vector);
 }
 
+bool isEmpty(const sf::FloatRect& rect) {
+	return rect.width <= 0.f || rect.height <= 0.f;
+}
+
+sf::FloatRect unite(const sf::FloatRect& lhs, const sf::FloatRect& rhs) {
+	if (isEmpty(lhs))
+		return rhs;
+	if (isEmpty(rhs))
+		return lhs;
+
+	float left = std::min(lhs.left, rhs.left);
+	float top = std::min(lhs.top, rhs.top);
+	float right = std::max(lhs.left + lhs.width, rhs.left + rhs.width);
+	float bottom = std::max(lhs.top + lhs.height, rhs.top + rhs.height);
+	return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+bool sweepAxis(float start, float move, float min, float max, float& enter, float& exit) {
+	if (std::abs(move) < 1e-6f)
+		return start > min && start < max;
+
+	float first = (min - start) / move;
+	float second = (max - start) / move;
+	enter = std::max(enter, std::min(first, second));
+	exit = std::min(exit, std::max(first, second));
+	return enter < exit;
+}
+
+bool sweptIntersects(const sf::FloatRect& lhs, sf::Vector2f lhsMove, const sf::FloatRect& rhs, sf::Vector2f rhsMove) {
+	// Casts the centre of lhs against rhs grown by the extents of lhs, in the frame of the moving rhs
+	sf::Vector2f move = lhsMove - rhsMove;
+	sf::Vector2f start(lhs.left + lhs.width / 2.f - move.x, lhs.top + lhs.height / 2.f - move.y);
+	float enter = 0.f;
+	float exit = 1.f;
+
+	return sweepAxis(start.x, move.x, rhs.left - lhs.width / 2.f, rhs.left + rhs.width + lhs.width / 2.f, enter, exit)
+		&& sweepAxis(start.y, move.y, rhs.top - lhs.height / 2.f, rhs.top + rhs.height + lhs.height / 2.f, enter, exit);
+}
+
 }
@@ -0,0 +1,101 @@
+#include "Utils/CollisionMask.hpp"
+
+#include <iostream>
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Opaque shapes on a transparent sheet, laid out like the entity texture
+const sf::IntRect Bar(0, 0, 16, 4);
+const sf::IntRect Dot(32, 0, 2, 2);
+const sf::IntRect Ring(40, 0, 8, 8);
+const sf::IntRect Wide(0, 8, 100, 2);
+const sf::IntRect Missing(0, 16, 4, 4);
+
+void fill(sf::Image& image, const sf::IntRect& rect) {
+    for (int y = rect.top; y < rect.top + rect.height; ++y)
+        for (int x = rect.left; x < rect.left + rect.width; ++x)
+            image.setPixel(x, y, sf::Color::White);
+}
+
+sf::Image createSheet() {
+    sf::Image image;
+    image.create(128, 32, sf::Color::Transparent);
+    fill(image, Bar);
+    fill(image, Dot);
+    fill(image, Ring);
+    fill(image, Wide);
+
+    // Hollow out the ring, leaving a one pixel border
+    for (int y = Ring.top + 1; y < Ring.top + Ring.height - 1; ++y)
+        for (int x = Ring.left + 1; x < Ring.left + Ring.width - 1; ++x)
+            image.setPixel(x, y, sf::Color::Transparent);
+
+    return image;
+}
+
+const CollisionMask* lookup(const CollisionMaskHolder& masks, const sf::IntRect& rect, float rotation) {
+    sf::Sprite sprite;
+    sprite.setTextureRect(rect);
+    return masks.get(sprite, rotation);
+}
+
+void testLookup(const CollisionMaskHolder& masks) {
+    const CollisionMask* upright = lookup(masks, Bar, 0.f);
+    check(upright != nullptr, "a loaded rect has a mask");
+    check(upright && upright->getSize() == sf::Vector2i(16, 4), "the upright mask has the size of its rect");
+    check(lookup(masks, Missing, 0.f) == nullptr, "a rect that was never loaded has no mask");
+
+    // 64 steps of 5.625 degrees, a rotation picks the nearest one
+    check(lookup(masks, Bar, 2.f) == upright, "a rotation below half a step uses the upright mask");
+    check(lookup(masks, Bar, 3.f) != upright, "a rotation above half a step uses the next one");
+    check(lookup(masks, Bar, 360.f) == upright, "a full turn wraps back to the upright mask");
+    check(lookup(masks, Bar, -90.f) == lookup(masks, Bar, 270.f), "negative rotations wrap to the same step");
+    check(lookup(masks, Bar, 90.f) == lookup(masks, Bar, 92.f), "rotations within one step share a mask");
+
+    const CollisionMask* turned = lookup(masks, Bar, 90.f);
+    check(turned && turned->getSize().x < turned->getSize().y, "a quarter turn stands the bar on its end");
+}
+
+void testBits(const CollisionMaskHolder& masks) {
+    const CollisionMask& bar = *lookup(masks, Bar, 0.f);
+    const CollisionMask& standing = *lookup(masks, Bar, 90.f);
+    const CollisionMask& dot = *lookup(masks, Dot, 0.f);
+    const CollisionMask& ring = *lookup(masks, Ring, 0.f);
+    const CollisionMask& wide = *lookup(masks, Wide, 0.f);
+    sf::Vector2f position(100.f, 100.f);
+
+    // The bar covers rows 98 to 101 around its centre
+    check(bar.test(position, dot, sf::Vector2f(100.f, 101.f)), "a dot on the bar hits");
+    check(!bar.test(position, dot, sf::Vector2f(100.f, 103.f)), "a dot just below the bar misses");
+    check(!bar.test(position, dot, sf::Vector2f(100.f, 106.f)), "the upright bar does not reach far down");
+    check(standing.test(position, dot, sf::Vector2f(100.f, 106.f)), "the standing bar does");
+    check(dot.test(sf::Vector2f(100.f, 101.f), bar, position), "the test does not depend on which mask asks");
+
+    // Bounding rects overlap, but the dot sits in the transparent middle
+    check(!ring.test(position, dot, position), "a dot inside a hollow ring misses");
+    check(ring.test(position, dot, sf::Vector2f(96.f, 100.f)), "a dot on the ring's border hits");
+
+    // Columns past the first 64 bit word of a row
+    check(wide.test(position, dot, sf::Vector2f(130.f, 100.f)), "a dot over the second word of a row hits");
+    check(!wide.test(position, dot, sf::Vector2f(152.f, 100.f)), "a dot past the end of a wide row misses");
+    check(wide.test(position, dot, sf::Vector2f(51.f, 100.f)), "a dot overlapping the row's first column hits");
+}
+
+int main() {
+    CollisionMaskHolder masks;
+    masks.load(createSheet(), {Bar, Dot, Ring, Wide, Bar});
+
+    testLookup(masks);
+    testBits(masks);
+
+    if (failures == 0)
+        std::cout << "CollisionMask: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}
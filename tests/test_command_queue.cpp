@@ -0,0 +1,110 @@
+#include "Utils/RingBuffer.hpp"
+#include "Game/CommandQueue.hpp"
+
+#include <iostream>
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+void testWrapAround() {
+    RingBuffer<int> ring(3);
+    check(ring.getCapacity() == 4, "capacity rounds up to a power of two");
+
+    // Every lap moves the head, after a few the live values straddle the end of the slots
+    int next = 0;
+    int expected = 0;
+    bool ordered = true;
+    for (int lap = 0; lap < 10; ++lap) {
+        for (int i = 0; i < 3; ++i)
+            ring.push(next++);
+        for (int i = 0; i < 2; ++i)
+            ordered = ordered && ring.pop() == expected++;
+    }
+
+    check(ordered, "values keep their order across the wrap");
+    check(ring.getSize() == 10, "pops and pushes are counted");
+    check(ring.getCapacity() == 16, "the ring only grows when it is full");
+}
+
+void testGrowth() {
+    RingBuffer<int> ring(4);
+
+    // Head at slot 3, so the values wrap when the ring fills up
+    for (int i = 0; i < 3; ++i)
+        ring.push(-1);
+    for (int i = 0; i < 3; ++i)
+        ring.pop();
+    for (int i = 0; i < 4; ++i)
+        ring.push(i);
+    check(ring.getCapacity() == 4, "a full ring has not grown yet");
+
+    ring.push(4);
+    check(ring.getCapacity() == 8, "pushing to a full ring doubles it");
+    check(ring.front() == 0, "the oldest value stays in front after growing");
+
+    bool ordered = true;
+    for (int expected = 0; expected <= 4; ++expected)
+        ordered = ordered && ring.pop() == expected;
+    check(ordered, "growing unwraps the values in order");
+    check(ring.isEmpty(), "every value comes out once");
+
+    for (int i = 0; i < 5; ++i)
+        ring.push(i);
+    ring.clear();
+    check(ring.isEmpty() && ring.getCapacity() == 8, "clear keeps the grown capacity");
+}
+
+Command makeCommand(unsigned int id) {
+    Command command;
+    command.category = id;
+    return command;
+}
+
+void testCommandQueue() {
+    CommandQueue queue;
+    const unsigned int commands = 200;
+
+    for (unsigned int i = 0; i < commands; ++i)
+        queue.push(makeCommand(i));
+    check(queue.isEmpty(), "pushed commands wait for the next swap");
+
+    queue.swapBuffers();
+    bool ordered = true;
+    unsigned int popped = 0;
+    while (!queue.isEmpty()) {
+        Command command = queue.pop();
+        ordered = ordered && command.category == popped++;
+
+        // Commands issued while this tick's run go to the next one
+        if (command.category % 50 == 0)
+            queue.push(makeCommand(commands + command.category));
+    }
+
+    check(ordered, "commands past the initial 64 slots come out in push order");
+    check(popped == commands, "a tick runs exactly the commands pushed before its swap");
+
+    queue.swapBuffers();
+    unsigned int next = 0;
+    ordered = true;
+    while (!queue.isEmpty()) {
+        ordered = ordered && queue.pop().category == commands + next;
+        next += 50;
+    }
+    check(ordered && next == 200, "commands pushed during a tick run on the next one");
+}
+
+int main() {
+    testWrapAround();
+    testGrowth();
+    testCommandQueue();
+
+    if (failures == 0)
+        std::cout << "CommandQueue: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include "Game/EventBus.hpp"
+#include "Objects/SceneNode.hpp"
+#include "Objects/SceneRegistry.hpp"
+#include "Objects/Entity.hpp"
+#include "Objects/ContactManager.hpp"
+
+#include <iostream>
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+// State of the contact between first and second, End + 1 when there is none
+int stateOf(const ContactManager& contacts, SceneNode& first, SceneNode& second) {
+    SceneNode::Pair pair(&first, &second);
+    for (const ContactManager::Contact& contact : contacts.getContacts()) {
+        if (contact.pair == pair)
+            return contact.state;
+    }
+    return ContactManager::End + 1;
+}
+
+// One collision pass, pairs come already ordered like the collision matrix orders them
+void step(ContactManager& contacts, std::initializer_list<SceneNode::Pair> pairs) {
+    contacts.beginUpdate();
+    for (const SceneNode::Pair& pair : pairs)
+        contacts.add(*pair.first, *pair.second);
+    contacts.endUpdate();
+}
+
+void testSequencing(SceneNode& a, SceneNode& b, SceneNode& c) {
+    ContactManager contacts;
+    SceneNode::Pair ab(&a, &b);
+    SceneNode::Pair bc(&b, &c);
+
+    step(contacts, {ab});
+    check(stateOf(contacts, a, b) == ContactManager::Begin, "a new pair begins");
+    check(contacts.getContacts().size() == 1, "only touching pairs are reported");
+
+    step(contacts, {ab, ab, bc});
+    check(stateOf(contacts, a, b) == ContactManager::Stay, "a pair touching again stays");
+    check(stateOf(contacts, b, c) == ContactManager::Begin, "a pair added next to a staying one begins");
+    check(contacts.getContacts().size() == 2, "a pair found twice in one pass is reported once");
+
+    step(contacts, {bc});
+    check(stateOf(contacts, a, b) == ContactManager::End, "a pair no longer touching ends");
+    check(stateOf(contacts, b, c) == ContactManager::Stay, "the other pair keeps staying");
+
+    step(contacts, {});
+    check(stateOf(contacts, a, b) == ContactManager::End + 1, "an ended pair is not reported again");
+    check(stateOf(contacts, b, c) == ContactManager::End, "the last pair ends on an empty pass");
+
+    step(contacts, {});
+    check(contacts.getContacts().empty(), "nothing is reported once every pair ended");
+}
+
+void testWrecks(SceneNode& root) {
+    SceneNode::Ptr first(new Entity(1, Category::PlayerAircraft));
+    SceneNode::Ptr second(new Entity(1, Category::EnemyAircraft));
+    SceneNode::Ptr third(new Entity(1, Category::EnemyProjectile));
+    Entity& player = static_cast<Entity&>(*first);
+    Entity& enemy = static_cast<Entity&>(*second);
+    Entity& bullet = static_cast<Entity&>(*third);
+    root.attachChild(std::move(first));
+    root.attachChild(std::move(second));
+    root.attachChild(std::move(third));
+
+    ContactManager contacts;
+    step(contacts, {SceneNode::Pair(&player, &enemy), SceneNode::Pair(&player, &bullet)});
+    step(contacts, {SceneNode::Pair(&player, &enemy), SceneNode::Pair(&player, &bullet)});
+    check(stateOf(contacts, player, bullet) == ContactManager::Stay, "both pairs stay before the hit");
+
+    // The bullet dies while touching, the world drops it from the contacts before freeing it
+    bullet.destroy();
+    check(bullet.isMarkedForRemoval(), "a destroyed entity is marked for removal");
+    contacts.removeWrecks();
+
+    step(contacts, {SceneNode::Pair(&player, &enemy)});
+    check(stateOf(contacts, player, bullet) == ContactManager::End + 1, "a wreck does not get an End event");
+    check(stateOf(contacts, player, enemy) == ContactManager::Stay, "the surviving pair keeps staying");
+    check(contacts.getContacts().size() == 1, "only the surviving pair is reported");
+
+    step(contacts, {});
+    check(stateOf(contacts, player, enemy) == ContactManager::End, "the surviving pair still ends normally");
+
+    root.removeWrecks();
+}
+
+int main() {
+    EventBus events;
+    SceneRegistry registry(events);
+    SceneNode root;
+    root.setRegistry(registry);
+
+    SceneNode a(Category::PlayerAircraft);
+    SceneNode b(Category::EnemyAircraft);
+    SceneNode c(Category::EnemyProjectile);
+    testSequencing(a, b, c);
+    testWrecks(root);
+
+    if (failures == 0)
+        std::cout << "ContactManager: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}
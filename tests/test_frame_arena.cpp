@@ -0,0 +1,92 @@
+#include "Utils/FrameArena.hpp"
+
+#include <iostream>
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+bool isAligned(const void* pointer, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+void testSpill() {
+    FrameArena arena(256);
+
+    unsigned char* first = static_cast<unsigned char*>(arena.allocate(200, 8));
+    check(arena.getUsed() == 200 && arena.getCapacity() == 256, "an allocation that fits stays in the first block");
+
+    // Does not fit in the 56 bytes left, so the tick spills into a new block
+    unsigned char* second = static_cast<unsigned char*>(arena.allocate(100, 16));
+    check(arena.getCapacity() == 512, "a spill adds a block as large as the last one");
+    check(second < first || second >= first + 256, "the spilled allocation lies outside the first block");
+    check(isAligned(second, 16), "a spilled allocation keeps its alignment");
+    check(arena.getUsed() == 300, "used counts every block");
+
+    // Larger than any block so far
+    void* huge = arena.allocate(1000, 8);
+    check(huge != nullptr && arena.getCapacity() >= 1512, "an oversized allocation gets a block that fits it");
+    check(arena.getPeak() == 1300, "the peak covers every allocation of the tick");
+
+    // Earlier allocations are untouched by later spills
+    for (int i = 0; i < 200; ++i)
+        first[i] = static_cast<unsigned char>(i);
+    for (int i = 0; i < 100; ++i)
+        second[i] = 0xff;
+    bool intact = true;
+    for (int i = 0; i < 200; ++i)
+        intact = intact && first[i] == static_cast<unsigned char>(i);
+    check(intact, "blocks do not overlap");
+}
+
+void testReset() {
+    FrameArena arena(128);
+    for (int i = 0; i < 10; ++i)
+        arena.allocate(100, 8);
+    std::size_t capacity = arena.getCapacity();
+
+    arena.reset();
+    check(arena.getUsed() == 0, "reset releases everything");
+    check(arena.getCapacity() == capacity, "reset keeps the capacity the tick grew to");
+    check(arena.getPeak() == 1000, "the peak survives a reset");
+
+    // The next tick of the same size fits in the merged block
+    for (int i = 0; i < 10; ++i)
+        arena.allocate(100, 8);
+    check(arena.getCapacity() == capacity, "a repeated tick no longer spills");
+
+    arena.reset();
+    void* first = arena.allocate(16, 8);
+    arena.reset();
+    check(arena.allocate(16, 8) == first, "memory is reused from the start after a reset");
+}
+
+void testVector() {
+    FrameArena arena(64);
+    FrameVector<int> values{ArenaAllocator<int>(arena)};
+
+    // Grows past the first block, each growth hands back the buffer it outgrew when it can
+    for (int i = 0; i < 1000; ++i)
+        values.push_back(i);
+
+    bool ordered = true;
+    for (int i = 0; i < 1000; ++i)
+        ordered = ordered && values[i] == i;
+    check(ordered, "a frame vector keeps its values across spills");
+    check(arena.getUsed() >= 1000 * sizeof(int), "the vector's storage comes from the arena");
+}
+
+int main() {
+    testSpill();
+    testReset();
+    testVector();
+
+    if (failures == 0)
+        std::cout << "FrameArena: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include "Utils/MpscQueue.hpp"
+
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <iostream>
+
+// Producer in the high half, its running sequence number in the low half
+typedef std::uint64_t Message;
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+void testCapacity() {
+    MpscQueue<int> queue(5);
+    check(queue.getCapacity() == 8, "capacity rounds up to a power of two");
+
+    for (int i = 0; i < 8; ++i)
+        check(queue.push(i), "push succeeds while there is room");
+    check(!queue.push(8), "push fails once the ring is full");
+
+    int value = -1;
+    check(queue.tryPop(value) && value == 0, "pop returns the oldest value");
+    check(queue.push(8), "a popped cell is reused");
+
+    for (int expected = 1; expected <= 8; ++expected)
+        check(queue.tryPop(value) && value == expected, "single producer values come out in order");
+    check(!queue.tryPop(value), "pop fails on an empty ring");
+}
+
+void testProducers(std::size_t producers, std::uint32_t messages) {
+    // Small ring, so producers keep running into a full queue and wrap many times
+    MpscQueue<Message> queue(64);
+    std::vector<std::thread> threads;
+
+    for (std::size_t producer = 0; producer < producers; ++producer) {
+        threads.emplace_back([&queue, producer, messages] {
+            for (std::uint32_t sequence = 0; sequence < messages; ++sequence) {
+                Message message = (static_cast<Message>(producer) << 32) | sequence;
+                while (!queue.push(message))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<std::uint32_t> next(producers, 0);
+    std::size_t received = 0;
+    bool ordered = true;
+    bool known = true;
+
+    while (received < producers * messages) {
+        Message message;
+        if (!queue.tryPop(message)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::size_t producer = static_cast<std::size_t>(message >> 32);
+        std::uint32_t sequence = static_cast<std::uint32_t>(message);
+        if (producer >= producers) {
+            known = false;
+            break;
+        }
+
+        // Each producer's messages arrive in the order it pushed them, with none lost or repeated
+        ordered = ordered && sequence == next[producer];
+        next[producer] = sequence + 1;
+        ++received;
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    Message leftover;
+    check(known, "every message comes from a running producer");
+    check(ordered, "messages of one producer keep their order");
+    check(!queue.tryPop(leftover), "nothing is left after every message was received");
+}
+
+int main() {
+    testCapacity();
+
+    for (std::size_t producers : {1, 2, 4, 8, 16})
+        testProducers(producers, 20000);
+
+    if (failures == 0)
+        std::cout << "MpscQueue: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}
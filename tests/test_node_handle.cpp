@@ -0,0 +1,77 @@
+#include "Game/EventBus.hpp"
+#include "Objects/SceneNode.hpp"
+#include "Objects/SceneRegistry.hpp"
+#include "Objects/Entity.hpp"
+
+#include <iostream>
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+void testSlotReuse() {
+    EventBus events;
+    SceneRegistry registry(events);
+    SceneNode first(Category::EnemyAircraft);
+    SceneNode second(Category::EnemyAircraft);
+
+    NodeHandle stale = registry.acquireHandle(first);
+    check(registry.resolve(stale) == &first, "a live handle resolves to its node");
+    check(registry.resolve(NodeHandle()) == nullptr, "a default handle resolves to nothing");
+
+    registry.releaseHandle(stale);
+    check(registry.resolve(stale) == nullptr, "a released handle resolves to nothing");
+
+    NodeHandle fresh = registry.acquireHandle(second);
+    check(fresh.index == stale.index, "the released slot is reused");
+    check(fresh.generation != stale.generation, "the reused slot gets a new generation");
+    check(fresh != stale, "handles of different generations differ");
+    check(registry.resolve(stale) == nullptr, "the old handle does not resolve to the slot's new node");
+    check(registry.resolve<SceneNode>(fresh) == &second, "the new handle resolves to the new node");
+
+    registry.releaseHandle(fresh);
+}
+
+void testSceneGraph() {
+    EventBus events;
+    SceneRegistry registry(events);
+    SceneNode root;
+    root.setRegistry(registry);
+
+    // Handles are what guided missiles keep to their target across ticks
+    SceneNode::Ptr node(new Entity(1, Category::EnemyAircraft));
+    Entity& target = static_cast<Entity&>(*node);
+    root.attachChild(std::move(node));
+    NodeHandle handle = target.getHandle();
+    check(registry.resolve<Entity>(handle) == &target, "an attached node's handle resolves to it");
+
+    target.destroy();
+    check(registry.resolve(handle) == &target, "a wreck still resolves until it is freed");
+    root.removeWrecks();
+    check(registry.resolve(handle) == nullptr, "a freed node's handle resolves to nothing");
+
+    SceneNode::Ptr spawned(new Entity(1, Category::EnemyAircraft));
+    SceneNode* replacement = spawned.get();
+    root.attachChild(std::move(spawned));
+    check(replacement->getHandle().index == handle.index, "the next spawn takes the freed slot");
+    check(registry.resolve(handle) == nullptr, "the old handle stays dead after its slot is reused");
+    check(registry.resolve(replacement->getHandle()) == replacement, "the spawn's own handle resolves to it");
+
+    NodeHandle replacementHandle = replacement->getHandle();
+    SceneNode::Ptr detached = root.detachChild(*replacement);
+    check(registry.resolve(replacementHandle) == nullptr, "detaching from the graph gives up the handle");
+}
+
+int main() {
+    testSlotReuse();
+    testSceneGraph();
+
+    if (failures == 0)
+        std::cout << "NodeHandle: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}
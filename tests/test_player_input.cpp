@@ -0,0 +1,76 @@
+#include "Game/PlayerInput.hpp"
+
+#include <iostream>
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+PlayerInput roundTrip(const PlayerInput& input) {
+    sf::Uint8 bytes[PlayerInput::SerializedSize];
+    input.serialize(bytes);
+    return PlayerInput::deserialize(bytes);
+}
+
+void testRoundTrip() {
+    const sf::Uint32 ticks[] = {0, 1, 255, 256, 65536, 0x12345678, 0xffffffff};
+
+    // Every tick against every combination of actions
+    bool equal = true;
+    for (sf::Uint32 tick : ticks) {
+        for (unsigned int mask = 0; mask < (1u << PlayerInput::ActionCount); ++mask) {
+            PlayerInput input;
+            input.tick = tick;
+            for (int action = 0; action < PlayerInput::ActionCount; ++action)
+                if ((mask >> action) & 1u)
+                    input.set(static_cast<PlayerInput::Action>(action));
+
+            PlayerInput copy = roundTrip(input);
+            equal = equal && copy.tick == input.tick && copy.actions == input.actions;
+        }
+    }
+
+    check(equal, "tick and actions survive a round trip");
+}
+
+void testLayout() {
+    PlayerInput input;
+    input.tick = 0x12345678;
+    input.set(PlayerInput::MoveLeft);
+    input.set(PlayerInput::Fire);
+
+    sf::Uint8 bytes[PlayerInput::SerializedSize];
+    input.serialize(bytes);
+
+    // The record is the same on every host, replays and peers read it byte by byte
+    check(bytes[0] == 0x78 && bytes[1] == 0x56 && bytes[2] == 0x34 && bytes[3] == 0x12, "the tick is little-endian");
+    check(bytes[4] == ((1u << PlayerInput::MoveLeft) | (1u << PlayerInput::Fire)), "actions are one bit each");
+}
+
+void testActions() {
+    PlayerInput input;
+    input.set(PlayerInput::MoveLeft);
+    input.set(PlayerInput::MoveRight);
+    input.set(PlayerInput::MoveUp);
+    input.set(PlayerInput::LaunchMissile);
+
+    PlayerInput copy = roundTrip(input);
+    check(copy.isActive(PlayerInput::LaunchMissile) && !copy.isActive(PlayerInput::Fire), "actions read back after a round trip");
+    check(copy.getAxis() == sf::Vector2f(0.f, -1.f), "opposite directions cancel out after a round trip");
+    check(PlayerInput().getAxis() == sf::Vector2f(), "no input means no movement");
+}
+
+int main() {
+    testRoundTrip();
+    testLayout();
+    testActions();
+
+    if (failures == 0)
+        std::cout << "PlayerInput: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include "Utils/Utility.hpp"
+
+#include <iostream>
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Bounds are where a node ended up this tick, moves are how far it went to get there
+void testTunnelling() {
+    // A 2 unit thick wall and a bullet covering 300 units per tick
+    sf::FloatRect wall(0.f, 100.f, 50.f, 2.f);
+    sf::FloatRect bullet(20.f, -100.f, 2.f, 8.f);
+    sf::Vector2f bulletMove(0.f, -300.f);
+
+    check(!bullet.intersects(wall), "the bullet has already passed the wall when the tick ends");
+    check(Utility::sweptIntersects(bullet, bulletMove, wall, sf::Vector2f()), "a bullet passing through a thin wall hits it");
+    check(Utility::sweptIntersects(wall, sf::Vector2f(), bullet, bulletMove), "the hit does not depend on the order of the rects");
+
+    sf::FloatRect beside(60.f, -100.f, 2.f, 8.f);
+    check(!Utility::sweptIntersects(beside, bulletMove, wall, sf::Vector2f()), "a bullet passing beside the wall misses");
+
+    sf::FloatRect shortOf(20.f, 120.f, 2.f, 8.f);
+    check(!Utility::sweptIntersects(shortOf, sf::Vector2f(0.f, -50.f), wall, sf::Vector2f()), "a bullet stopping short of the wall misses");
+
+    sf::FloatRect diagonal(80.f, -100.f, 2.f, 8.f);
+    check(Utility::sweptIntersects(diagonal, sf::Vector2f(60.f, -300.f), wall, sf::Vector2f()), "a diagonal path crossing the wall hits");
+}
+
+void testMovingTarget() {
+    sf::FloatRect bullet(20.f, -100.f, 2.f, 8.f);
+    sf::FloatRect wall(0.f, -200.f, 50.f, 2.f);
+
+    // Both moved the same way, so the bullet stayed below the wall the whole tick
+    check(!Utility::sweptIntersects(bullet, sf::Vector2f(0.f, -300.f), wall, sf::Vector2f(0.f, -300.f)),
+        "nodes moving together never meet");
+
+    // The wall came down through the bullet's path while the bullet went up
+    sf::FloatRect fallen(0.f, -50.f, 50.f, 2.f);
+    check(Utility::sweptIntersects(bullet, sf::Vector2f(0.f, -300.f), fallen, sf::Vector2f(0.f, 200.f)),
+        "a bullet and a target moving towards each other meet");
+}
+
+void testResting() {
+    sf::FloatRect lhs(0.f, 0.f, 10.f, 10.f);
+    sf::FloatRect overlapping(5.f, 5.f, 10.f, 10.f);
+    sf::FloatRect apart(20.f, 0.f, 10.f, 10.f);
+
+    check(Utility::sweptIntersects(lhs, sf::Vector2f(), overlapping, sf::Vector2f()), "resting rects that overlap intersect");
+    check(!Utility::sweptIntersects(lhs, sf::Vector2f(), apart, sf::Vector2f()), "resting rects apart do not");
+}
+
+int main() {
+    testTunnelling();
+    testMovingTarget();
+    testResting();
+
+    if (failures == 0)
+        std::cout << "sweptIntersects: all tests passed\n";
+    return failures == 0 ? 0 : 1;
+}